@@ -0,0 +1,253 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/bench/ActionBench.cc
+/// \brief Cost of the user stepping and stacking actions on synthetic steps
+//
+// usage: actionBench [iterations]
+// The geometry is the default slab of DetectorConstruction; no run manager
+// and no physics list are built. Each case hands the same synthetic G4Step
+// to SteppingAction::UserSteppingAction (or the same G4Track to
+// StackingAction::ClassifyNewTrack) in a tight loop and reports ns/call and
+// heap allocations per call, counted by the replaced operator new below.
+// The actions are specialized per run (ScoringPolicies.hh): each scoring
+// configuration is switched on, the actions re-specialized with BeginOfRun,
+// and timed on the same steps; the removal path is selected by a neutron
+// beam. Event budgets and lanes need a run manager and a rebuilt geometry
+// and are not covered.
+//
+
+#include "DetectorConstruction.hh"
+#include "PhysicsList.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "SteppingAction.hh"
+#include "StackingAction.hh"
+#include "ExitFaceScorer.hh"
+#include "MemoryReport.hh"
+#include "PerturbationEstimator.hh"
+#include "ExpectedValueEstimator.hh"
+
+#include "G4Navigator.hh"
+#include "G4TouchableHandle.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleGun.hh"
+#include "G4StackManager.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Neutron.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+  std::size_t gAllocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+  ++gAllocations;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// a track at the given point, with the touchables of its step
+struct SyntheticStep
+{
+  SyntheticStep(G4Navigator& navigator, const G4ParticleDefinition* particle,
+                G4double energy, const G4ThreeVector& direction,
+                const G4ThreeVector& pre, const G4ThreeVector* next,
+                G4int parentID)
+  {
+    track = new G4Track(new G4DynamicParticle(particle, direction, energy),
+                        0., pre);
+    track->SetTrackID(parentID + 1);
+    track->SetParentID(parentID);
+    track->SetStep(&step);
+    step.SetTrack(track);
+
+    navigator.LocateGlobalPointAndSetup(pre, nullptr, false, true);
+    G4TouchableHandle preTouchable = navigator.CreateTouchableHistoryHandle();
+    step.GetPreStepPoint()->SetTouchableHandle(preTouchable);
+    track->SetTouchableHandle(preTouchable);
+
+    // a null next touchable is a track leaving the world
+    if (next) {
+      navigator.LocateGlobalPointAndSetup(*next, nullptr, false, true);
+      G4TouchableHandle nextTouchable = navigator.CreateTouchableHistoryHandle();
+      step.GetPostStepPoint()->SetTouchableHandle(nextTouchable);
+      track->SetNextTouchableHandle(nextTouchable);
+    }
+  }
+
+  ~SyntheticStep() { delete track; }
+
+  G4Step   step;
+  G4Track* track = nullptr;
+};
+
+template <class Call>
+void Time(const char* name, long n, Call call)
+{
+  for (long i = 0; i < n/100; ++i) call();   // warm up
+
+  std::size_t allocations = gAllocations;
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < n; ++i) call();
+  auto stop = std::chrono::steady_clock::now();
+  allocations = gAllocations - allocations;
+
+  double seconds = std::chrono::duration<double>(stop - start).count();
+  std::printf("%-52s %8.2f ns/call  %6.3f allocations/call\n",
+              name, 1.e9*seconds/n, double(allocations)/n);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  long n = (argc > 1) ? std::atol(argv[1]) : 10000000L;
+
+  G4Gamma::Definition();
+  G4Electron::Definition();
+  G4Positron::Definition();
+  G4Neutron::Definition();
+
+  DetectorConstruction* detector = new DetectorConstruction();
+  G4VPhysicalVolume* world = detector->Construct();
+  PrimaryGeneratorAction* primary = new PrimaryGeneratorAction(detector);
+  const G4double energy = 1.*MeV;
+  primary->GetParticleGun()->SetParticleDefinition(G4Gamma::Gamma());
+  primary->GetParticleGun()->SetParticleEnergy(energy);
+  RunAction* run = new RunAction(detector, primary);
+  SteppingAction stepping(primary, run, detector);
+  PhysicsList* physics = new PhysicsList(detector);
+  StackingAction stacking(run, physics);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  // the slab spans |x| < 1 mm, the world |x| < 10 km
+  const G4ThreeVector beam(1.,0.,0.);
+  const G4ThreeVector inSlab(0.,0.,0.);
+  const G4ThreeVector inWorld(1.*m,0.,0.);
+  const G4ThreeVector worldEdge(10.*km,0.,0.);
+
+  SyntheticStep slabStep(navigator, G4Gamma::Gamma(), energy, beam,
+                         inSlab, &inSlab, 0);
+  SyntheticStep crossing(navigator, G4Gamma::Gamma(), energy, beam,
+                         inSlab, &inWorld, 0);
+  SyntheticStep scattered(navigator, G4Electron::Electron(), 0.3*energy,
+                          G4ThreeVector(0.6,0.8,0.), inSlab, &inWorld, 1);
+  SyntheticStep leaving(navigator, G4Gamma::Gamma(), energy, beam,
+                        worldEdge, nullptr, 0);
+
+  std::printf("%ld calls per case\n", n);
+  Time("stepping, leaving world", n,
+       [&]{ stepping.UserSteppingAction(&leaving.step); });
+  Time("stepping, crossing, secondary", n,
+       [&]{ stepping.UserSteppingAction(&scattered.step); });
+
+  // scoring configurations, from the narrow beam alone to all options
+  ExitFaceScorer* exitFaceScorer = run->GetExitFaceScorer();
+  PerturbationEstimator* perturbation = run->GetPerturbation();
+  ExpectedValueEstimator* expectedValue = run->GetExpectedValue();
+  struct Configuration
+  { const char* name; G4bool exitFace, processes, expected, removal; };
+  const Configuration configurations[] = {
+    {"narrow beam",                      false, false, false, false},
+    {"broad beam",                       true,  false, false, false},
+    {"process-resolved",                 false, true,  false, false},
+    {"expected value",                   false, false, true,  false},
+    {"broad beam + process-resolved",    true,  true,  false, false},
+    {"removal (neutron beam)",           false, false, false, true }};
+  G4ParticleGun* gun = primary->GetParticleGun();
+  for (const Configuration& configuration : configurations) {
+    // the removal path is chosen from the beam particle; the synthetic
+    // steps stay the same
+    gun->SetParticleDefinition(configuration.removal ?
+      static_cast<G4ParticleDefinition*>(G4Neutron::Neutron()) :
+      static_cast<G4ParticleDefinition*>(G4Gamma::Gamma()));
+    exitFaceScorer->SetActive(configuration.exitFace);
+    exitFaceScorer->Reset(energy);
+    perturbation->Clear();
+    if (configuration.processes) perturbation->AddDensity(1.01);
+    perturbation->BeginOfRun(G4Gamma::Gamma(),
+                             std::vector<G4double>(1, energy), nullptr);
+    expectedValue->SetActive(configuration.expected);
+    expectedValue->BeginOfRun(G4Gamma::Gamma());
+    stepping.BeginOfRun();
+
+    std::string name = std::string("stepping, ") + configuration.name;
+    // a new event per call: the expected value scores the uncollided
+    // primary, collided after its first step otherwise
+    Time((name + ", in slab").c_str(), n,
+         [&]{ expectedValue->BeginOfEvent();
+              stepping.UserSteppingAction(&slabStep.step);
+              expectedValue->EndOfEvent(); });
+    Time((name + ", crossing").c_str(), n,
+         [&]{ stepping.UserSteppingAction(&crossing.step); });
+  }
+  exitFaceScorer->SetActive(false);
+  gun->SetParticleDefinition(G4Gamma::Gamma());
+  stepping.BeginOfRun();
+
+  stacking.BeginOfRun();
+  Time("stacking", n,
+       [&]{ stacking.ClassifyNewTrack(crossing.track); });
+  physics->SetKillThreshold("all", 1.*keV);
+  stacking.BeginOfRun();
+  Time("stacking, kill thresholds", n,
+       [&]{ stacking.ClassifyNewTrack(scattered.track); });
+  physics->SetKillThreshold("all", 0.);
+  G4StackManager stackManager;
+  stacking.SetStackManager(&stackManager);
+  run->GetMemoryReport()->SetActive(true);
+  stacking.BeginOfRun();
+  Time("stacking, memory report on", n,
+       [&]{ stacking.ClassifyNewTrack(crossing.track); });
+  run->GetMemoryReport()->SetActive(false);
+
+  std::printf("transmitted %g (checksum)\n", run->GetTransmitted());
+
+  delete run;
+  delete physics;
+  delete primary;
+  delete detector;
+  return 0;
+}
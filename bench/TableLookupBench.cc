@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/bench/TableLookupBench.cc
+/// \brief Lookup rate of AttenuationTable, without Geant4
+//
+// usage: tableLookupBench [table.mutb] [lookups]
+// Without a file a synthetic 1000-point power-law table is used. Energies
+// are drawn log-uniformly over the table range before the timed loop.
+//
+
+#include "AttenuationTable.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char** argv)
+{
+  AttenuationTable table;
+  if (argc > 1) {
+    if (!table.Read(argv[1])) {
+      std::fprintf(stderr, "cannot read table %s\n", argv[1]);
+      return 1;
+    }
+  }
+  else {
+    AttenuationTable::Material material;
+    material.name = "synthetic";
+    material.lnEmin = std::log(1.e-3);
+    material.lnEmax = std::log(1.e+2);
+    const int n = 1000;
+    for (int i = 0; i < n; ++i) {
+      double lnE = material.lnEmin + i*(material.lnEmax - material.lnEmin)/(n-1);
+      material.lnMu.push_back(float(-2.5*lnE));
+    }
+    table.AddMaterial(material);
+  }
+  long nLookups = (argc > 2) ? std::atol(argv[2]) : 10000000L;
+
+  for (const AttenuationTable::Material& material : table.GetMaterials()) {
+    std::mt19937_64 engine(12345);
+    std::uniform_real_distribution<double> lnE(material.lnEmin, material.lnEmax);
+    std::vector<double> energies(1 << 16);
+    for (double& energy : energies) energy = std::exp(lnE(engine));
+
+    double sum = 0.;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < nLookups; ++i)
+      sum += material.MuOverRho(energies[i & 0xffff]);
+    auto stop = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::printf("%-24s %5zu points  %.3g lookups/s  (%.1f ns/lookup, checksum %g)\n",
+                material.name.c_str(), material.lnMu.size(),
+                nLookups/seconds, 1.e9*seconds/nLookups, sum);
+  }
+  return 0;
+}
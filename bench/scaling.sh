@@ -0,0 +1,21 @@
+#!/bin/sh
+# Events/s against thread count, with and without worker pinning.
+#
+# usage: bench/scaling.sh <attenuation executable> [max threads] [socket]
+# Run from the build directory (scaling.mac is copied there). Writes
+# scaling.csv: policy,threads,events_per_s
+#
+exe=${1:?usage: scaling.sh <executable> [max threads] [socket]}
+max=${2:-$(nproc)}
+export SOCKET=${3:--1}
+
+echo "policy,threads,events_per_s" > scaling.csv
+for policy in none compact scatter; do
+  export PINNING=$policy
+  n=1
+  while [ "$n" -le "$max" ]; do
+    rate=$("$exe" scaling.mac -t "$n" | awk '/events\/s/ {print $(NF-1)}' | tail -1)
+    echo "$policy,$n,$rate" | tee -a scaling.csv
+    n=$((n * 2))
+  done
+done
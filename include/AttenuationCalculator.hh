@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/AttenuationCalculator.hh
+/// \brief Definition of the AttenuationCalculator class
+//
+// Analytic (model based) macroscopic cross sections of the active physics
+// list, used to steer the Monte Carlo runs. Physics tables must have been
+// built (/run/beamOn 0) before any of these methods is called.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef AttenuationCalculator_h
+#define AttenuationCalculator_h 1
+
+#include "G4EmCalculator.hh"
+#include "globals.hh"
+
+class G4Material;
+class G4ParticleDefinition;
+
+class AttenuationCalculator
+{
+  public:
+    AttenuationCalculator();
+   ~AttenuationCalculator();
+
+  public:
+    // total macroscopic cross section (1/length) summed over the
+    // electromagnetic processes registered for the particle
+    G4double ComputeCrossSectionPerVolume(const G4ParticleDefinition*,
+                                          G4double energy,
+                                          const G4Material*);
+
+    // same sum from the physics tables used by tracking
+    G4double GetCrossSectionPerVolume(const G4ParticleDefinition*,
+                                      G4double energy,
+                                      const G4Material*);
+
+    // mass attenuation coefficient (area/mass)
+    G4double ComputeMassAttenuation(const G4ParticleDefinition*,
+                                    G4double energy,
+                                    const G4Material*);
+
+    // hadronic macroscopic cross sections of G4HadronicProcessStore (zero
+    // without hadronic physics): inelastic only, which removes the primary,
+    // and inelastic + elastic + capture + fission, which scatter it as well
+    G4double GetRemovalCrossSectionPerVolume(const G4ParticleDefinition*,
+                                             G4double energy,
+                                             const G4Material*);
+    G4double GetHadronicCrossSectionPerVolume(const G4ParticleDefinition*,
+                                              G4double energy,
+                                              const G4Material*);
+
+  private:
+    G4double ElectronEnergyCut(const G4Material*);
+
+    G4EmCalculator fEmCalculator;
+};
+
+#endif
@@ -0,0 +1,189 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/AttenuationTable.hh
+/// \brief Definition of the AttenuationTable class
+//
+// Compact binary tables of mu/rho(E) per material and their lookup.
+// Header only and plain C++17, without Geant4: downstream tools include
+// this file alone. TableExporter writes the files from a Geant4 session.
+//
+// File layout, native byte order, strings as uint32 length + bytes:
+//   char[4] "MUTB", uint32 version
+//   string physics list, string Geant4 version, string particle
+//   double range cuts of gamma, e-, e+ (mm), of the Target region
+//   uint32 number of materials, then per material:
+//     string name, double density (g/cm3),
+//     double ln(Emin/MeV), double ln(Emax/MeV), uint32 n,
+//     float ln(mu/rho / (cm2/g)) at n energies uniform in ln(E)
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef AttenuationTable_h
+#define AttenuationTable_h 1
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class AttenuationTable
+{
+  public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    struct Material
+    {
+      std::string        name;
+      double             density = 0.;     // g/cm3
+      double             lnEmin = 0.;      // ln(E/MeV) of the first point
+      double             lnEmax = 0.;      // ln(E/MeV) of the last point
+      std::vector<float> lnMu;             // ln(mu/rho / (cm2/g))
+
+      // log-log interpolation, clamped to the table ends; the uniform
+      // ln(E) grid gives the interval without a search
+      double MuOverRho(double energyMeV) const
+      {
+        const std::size_t n = lnMu.size();
+        const double last = double(n - 1);
+        double x = (std::log(energyMeV) - lnEmin)*last/(lnEmax - lnEmin);
+        x = std::min(std::max(x, 0.), last);
+        const std::size_t i = std::min(std::size_t(x), n - 2);
+        const double f = x - double(i);
+        return std::exp(lnMu[i] + f*(lnMu[i+1] - lnMu[i]));
+      }
+    };
+
+  public:
+    const std::string& GetPhysicsList() const   {return fPhysicsList;};
+    const std::string& GetGeant4Version() const {return fGeant4Version;};
+    const std::string& GetParticle() const      {return fParticle;};
+    const double* GetCuts() const               {return fCuts;};
+    const std::vector<Material>& GetMaterials() const {return fMaterials;};
+
+    void SetMetadata(const std::string& physicsList,
+                     const std::string& geant4Version,
+                     const std::string& particle,
+                     double gammaCut, double electronCut, double positronCut)
+    {
+      fPhysicsList = physicsList;
+      fGeant4Version = geant4Version;
+      fParticle = particle;
+      fCuts[0] = gammaCut;
+      fCuts[1] = electronCut;
+      fCuts[2] = positronCut;
+    }
+
+    void AddMaterial(const Material& material) {fMaterials.push_back(material);};
+
+    const Material* Find(const std::string& name) const
+    {
+      for (const Material& material : fMaterials)
+        if (material.name == name) return &material;
+      return nullptr;
+    }
+
+    bool Write(const std::string& fileName) const
+    {
+      std::ofstream out(fileName, std::ios::binary);
+      if (!out.is_open()) return false;
+      out.write("MUTB", 4);
+      Put(out, kVersion);
+      PutString(out, fPhysicsList);
+      PutString(out, fGeant4Version);
+      PutString(out, fParticle);
+      out.write(reinterpret_cast<const char*>(fCuts), sizeof(fCuts));
+      Put(out, std::uint32_t(fMaterials.size()));
+      for (const Material& material : fMaterials) {
+        PutString(out, material.name);
+        Put(out, material.density);
+        Put(out, material.lnEmin);
+        Put(out, material.lnEmax);
+        Put(out, std::uint32_t(material.lnMu.size()));
+        out.write(reinterpret_cast<const char*>(material.lnMu.data()),
+                  material.lnMu.size()*sizeof(float));
+      }
+      return bool(out);
+    }
+
+    // false on a missing file, a foreign file or an unknown version
+    bool Read(const std::string& fileName)
+    {
+      std::ifstream in(fileName, std::ios::binary);
+      char magic[4];
+      std::uint32_t version = 0;
+      if (!in.read(magic, 4) || std::memcmp(magic, "MUTB", 4) != 0) return false;
+      if (!Get(in, version) || version != kVersion) return false;
+
+      std::uint32_t nMaterials = 0;
+      if (!GetString(in, fPhysicsList) || !GetString(in, fGeant4Version) ||
+          !GetString(in, fParticle) ||
+          !in.read(reinterpret_cast<char*>(fCuts), sizeof(fCuts)) ||
+          !Get(in, nMaterials)) return false;
+
+      fMaterials.assign(nMaterials, Material());
+      for (Material& material : fMaterials) {
+        std::uint32_t n = 0;
+        if (!GetString(in, material.name) || !Get(in, material.density) ||
+            !Get(in, material.lnEmin) || !Get(in, material.lnEmax) ||
+            !Get(in, n) || n < 2) return false;
+        material.lnMu.resize(n);
+        if (!in.read(reinterpret_cast<char*>(material.lnMu.data()),
+                     n*sizeof(float))) return false;
+      }
+      return true;
+    }
+
+  private:
+    template <class T> static void Put(std::ofstream& out, const T& val)
+    { out.write(reinterpret_cast<const char*>(&val), sizeof(T)); }
+
+    template <class T> static bool Get(std::ifstream& in, T& val)
+    { return bool(in.read(reinterpret_cast<char*>(&val), sizeof(T))); }
+
+    static void PutString(std::ofstream& out, const std::string& val)
+    {
+      Put(out, std::uint32_t(val.size()));
+      out.write(val.data(), val.size());
+    }
+
+    static bool GetString(std::ifstream& in, std::string& val)
+    {
+      std::uint32_t size = 0;
+      if (!Get(in, size) || size > (1u << 20)) return false;
+      val.resize(size);
+      return bool(in.read(&val[0], size));
+    }
+
+    std::string           fPhysicsList;
+    std::string           fGeant4Version;
+    std::string           fParticle;
+    double                fCuts[3] = {0., 0., 0.};
+    std::vector<Material> fMaterials;
+};
+
+#endif
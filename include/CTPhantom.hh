@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/CTPhantom.hh
+/// \brief Definition of the CTPhantom class
+//
+// Voxelised CT volume replacing the slab. Voxels are placed either with a
+// G4PhantomParameterisation and regular navigation (default), or as one
+// G4PVPlacement per voxel, kept only as the naive reference for navigation
+// benchmarks.
+//
+// Voxel file: first line "nx ny nz dx dy dz" (mm), then nx*ny*nz HU values,
+//             x running fastest.
+// HU table  : one "HUmax material" line per range, ascending; a voxel takes
+//             the first range with HU <= HUmax. Its density follows the
+//             linear calibration rho = (HU+1000)/1000 g/cm3, rounded to
+//             the density step, with the NIST composition of the material.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CTPhantom_h
+#define CTPhantom_h 1
+
+#include "globals.hh"
+#include <vector>
+#include <map>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+class G4Material;
+class CTPhantomMessenger;
+
+class CTPhantom
+{
+  public:
+    CTPhantom();
+   ~CTPhantom();
+
+  public:
+    void SetActive(G4bool val)                {fActive = val;};
+    G4bool IsActive() const                   {return fActive;};
+    void SetVoxelFile(const G4String& val)    {fVoxelFile = val;};
+    void SetHUTableFile(const G4String& val)  {fHUTableFile = val;};
+    void SetRegularNavigation(G4bool val)     {fRegular = val;};
+    void SetDensityStep(G4double val)         {fDensityStep = val;};
+
+    // read the files and place the voxels in a container inside mother
+    G4VPhysicalVolume* Construct(G4LogicalVolume* mother);
+
+    G4int GetNx() const {return fNx;};
+    G4int GetNy() const {return fNy;};
+    G4int GetNz() const {return fNz;};
+    G4double GetVoxelX() const {return fDx;};
+    G4double GetVoxelY() const {return fDy;};
+    G4double GetVoxelZ() const {return fDz;};
+
+  private:
+    G4bool ReadHUTable();
+    G4bool ReadVoxels();
+    G4Material* VoxelMaterial(G4int hu);
+
+    CTPhantomMessenger* fMessenger;
+
+    G4bool   fActive;
+    G4bool   fRegular;
+    G4String fVoxelFile;
+    G4String fHUTableFile;
+    G4double fDensityStep;
+
+    G4int    fNx, fNy, fNz;
+    G4double fDx, fDy, fDz;
+
+    std::vector<G4int>       fHUMax;
+    std::vector<G4Material*> fHUMaterial;
+
+    // one material per (HU range, density bin)
+    std::vector<G4Material*>          fMaterials;
+    std::map<std::pair<std::size_t,G4int>, std::size_t> fMaterialIndex;
+    std::vector<std::size_t>          fVoxelMaterial;
+};
+
+#endif
@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/Checkpoint.hh
+/// \brief Definition of the Checkpoint class
+//
+// Periodic checkpoints of a run: every N events and/or T seconds the run
+// tallies, the number of events done and the random engine status go to
+// one file, written to a temporary and renamed so that a killed job always
+// leaves a complete checkpoint.
+//
+// With --resume the run named in the checkpoint restarts from its tallies
+// and engine state and stops once the requested total is reached: the
+// result is that of the uninterrupted run. Earlier runs of the macro,
+// already written out, are skipped. Sequential run manager only.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef Checkpoint_h
+#define Checkpoint_h 1
+
+#include "globals.hh"
+#include <chrono>
+
+class G4Run;
+class RunAction;
+class CheckpointMessenger;
+
+class Checkpoint
+{
+  public:
+    Checkpoint(RunAction*);
+   ~Checkpoint();
+
+  public:
+    void SetEveryEvents(G4int val)        {fEveryEvents = val;};
+    void SetEverySeconds(G4double val)    {fEverySeconds = val;};
+    void SetFileName(const G4String& val) {fFileName = val;};
+    // continue from <file>; output files are then appended to
+    void SetResume(G4bool);
+
+    // returns the number of events restored into the run tallies
+    G4int BeginOfRun(const G4Run*);
+    void  EndOfEvent();
+    void  EndOfRun();
+
+    // the run was completed by an earlier job: no result is written
+    G4bool IsSkipping() const             {return fSkipping;};
+
+  private:
+    G4bool ReadHeader();
+    void   Write();
+
+    RunAction*           fRunAction;
+    CheckpointMessenger* fMessenger;
+
+    G4int    fEveryEvents;       // 0: no event trigger
+    G4double fEverySeconds;      // 0: no time trigger
+    G4String fFileName;
+
+    // current run
+    G4int    fRunID;
+    G4int    fEventsRequested;
+    G4int    fEventsDone;
+    G4int    fRestoredEvents;
+    G4bool   fSkipping;
+    std::chrono::steady_clock::time_point fLastWrite;
+
+    // checkpoint being resumed
+    G4bool   fResumePending;
+    G4int    fResumeRunID;
+    G4int    fResumeEvents;
+};
+
+#endif
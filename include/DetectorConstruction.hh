@@ -35,11 +35,17 @@
 
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
+#include <vector>
 
 class G4LogicalVolume;
 class G4Material;
 class DetectorMessenger;
 class G4Box;
+class G4ParticleDefinition;
+class AttenuationCalculator;
+class SlabFastSimModel;
+class G4Region;
+class CTPhantom;
 
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -52,13 +58,40 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     
      virtual
      G4VPhysicalVolume* Construct();             
+     virtual
+     void ConstructSDandField();
      void SetMaterial (G4String);   
      void SetThickness (G4double);         
+
+     // auto-thickness mode: before each run the slab is resized so that
+     // mu*x equals the target value for the current particle and energy
+     void SetAutoThickness (G4bool val)  {fAutoThickness = val;};
+     void SetTargetMuX (G4double val)    {fTargetMuX = val;};
+     G4bool GetAutoThickness()           {return fAutoThickness;};
+     void OptimizeThickness (const G4ParticleDefinition*, G4double);
+
+     // fast simulation of primary gammas in the slab (SlabFastSimModel),
+     // chosen before initialization: model and physics only exist then
+     void SetFastSimulation (G4bool val)   {fFastSimulation = val;};
+     G4bool GetFastSimulation();
+
+     // voxelised CT volume in place of the slab (/testem/phantom/)
+     CTPhantom* GetPhantom()               {return fPhantom;};
+
+     // lanes: slabs of different materials side by side along y, all of
+     // the slab thickness, with copy number = lane index (from -y to +y)
+     void AddLane (const G4String&);
+     void SetLaneWidth (G4double val)      {fLaneWidth = val;};
+     G4int GetNumberOfLanes() const        {return fLaneMaterials.size();};
+     G4double GetLaneWidth() const         {return fLaneWidth;};
+     G4Material* GetLaneMaterial(G4int i)  {return fLaneMaterials[i];};
      
   public:
   
      const
      G4VPhysicalVolume* GetWorld()      {return fBox;};                               
+     const
+     G4VPhysicalVolume* GetWorldVolume() {return fworld;};
      G4Material*        GetMaterial()   {return fMaterial;};
      
      void               PrintParameters();
@@ -75,6 +108,19 @@ class DetectorConstruction : public G4VUserDetectorConstruction
      DetectorMessenger*    fDetectorMessenger;
      G4Material*           fVacuum; 
      G4Material*           fWater;
+
+     G4bool                 fAutoThickness;
+     G4double               fTargetMuX;
+     AttenuationCalculator* fCalculator;
+
+     G4Region*              fSlabRegion;
+     G4bool                 fFastSimulation;
+     static G4ThreadLocal SlabFastSimModel* fFastSimModel;
+
+     CTPhantom*             fPhantom;
+
+     std::vector<G4Material*> fLaneMaterials;
+     G4double                 fLaneWidth;
    
   private:
     
@@ -40,6 +40,8 @@ class DetectorConstruction;
 class G4UIdirectory;
 class G4UIcmdWithAString;
 class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithADouble;
+class G4UIcmdWithABool;
 
 class DetectorMessenger: public G4UImessenger
 {
@@ -59,6 +61,11 @@ class DetectorMessenger: public G4UImessenger
     G4UIdirectory*             fDetDir;
     G4UIcmdWithAString*        fMaterCmd; 
     G4UIcmdWithADoubleAndUnit* fThickCmd;
+    G4UIcmdWithABool*          fAutoThickCmd;
+    G4UIcmdWithADouble*        fMuXCmd;
+    G4UIcmdWithABool*          fFastSimCmd;
+    G4UIcmdWithAString*        fAddLaneCmd;
+    G4UIcmdWithADoubleAndUnit* fLaneWidthCmd;
 };
 
 #endif
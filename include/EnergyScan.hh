@@ -0,0 +1,87 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/EnergyScan.hh
+/// \brief Definition of the EnergyScan class
+//
+// Adaptive energy scan: the grid is refined where the analytic mu(E) of the
+// active physics list departs from a log-log interpolation between its
+// neighbours (absorption edges), then one Monte Carlo run is done per point.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef EnergyScan_h
+#define EnergyScan_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class PrimaryGeneratorAction;
+class EnergyScanMessenger;
+class AttenuationCalculator;
+
+class EnergyScan
+{
+  public:
+    EnergyScan(DetectorConstruction*, PrimaryGeneratorAction*);
+   ~EnergyScan();
+
+  public:
+    void SetEnergyMin(G4double val)  {fEnergyMin = val;};
+    void SetEnergyMax(G4double val)  {fEnergyMax = val;};
+    void SetTolerance(G4double val)  {fTolerance = val;};
+    void SetMaxPoints(G4int val)     {fMaxPoints = val;};
+    void SetInitialPoints(G4int val) {fInitialPoints = val;};
+    void SetEventsPerPoint(G4int val){fEventsPerPoint = val;};
+
+    // build the grid only
+    void BuildGrid();
+    // build the grid and do one beamOn per point
+    void Run();
+
+    const std::vector<G4double>& GetEnergies() const {return fEnergies;};
+
+  private:
+    G4double ComputeMu(G4double energy);
+
+    DetectorConstruction*   fDetector;
+    PrimaryGeneratorAction* fPrimary;
+    EnergyScanMessenger*    fMessenger;
+    AttenuationCalculator*  fCalculator;
+
+    G4double fEnergyMin;
+    G4double fEnergyMax;
+    G4double fTolerance;     // max relative interpolation error on mu
+    G4double fMinRelWidth;   // intervals narrower than this are not split
+    G4int    fMaxPoints;
+    G4int    fInitialPoints;
+    G4int    fEventsPerPoint;
+
+    std::vector<G4double> fEnergies;
+    std::vector<G4double> fMu;
+    std::vector<G4double> fError;
+};
+
+#endif
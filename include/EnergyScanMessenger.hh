@@ -0,0 +1,67 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/EnergyScanMessenger.hh
+/// \brief Definition of the EnergyScanMessenger class
+//
+
+#ifndef EnergyScanMessenger_h
+#define EnergyScanMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class EnergyScan;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+class EnergyScanMessenger: public G4UImessenger
+{
+  public:
+  
+    EnergyScanMessenger(EnergyScan* );
+   ~EnergyScanMessenger();
+
+    virtual    
+    void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+  
+    EnergyScan*                fScan;
+    
+    G4UIdirectory*             fScanDir;
+    G4UIcmdWithADoubleAndUnit* fEminCmd;
+    G4UIcmdWithADoubleAndUnit* fEmaxCmd;
+    G4UIcmdWithADouble*        fTolCmd;
+    G4UIcmdWithAnInteger*      fMaxPointsCmd;
+    G4UIcmdWithAnInteger*      fInitPointsCmd;
+    G4UIcmdWithAnInteger*      fEventsCmd;
+    G4UIcmdWithoutParameter*   fGridCmd;
+    G4UIcmdWithoutParameter*   fRunCmd;
+};
+
+#endif
@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/EventWatchdog.hh
+/// \brief Definition of the EventWatchdog class
+//
+// Per-event budgets of steps and of wall time, checked from the stepping
+// action. An event over budget is aborted and counted apart; its random
+// engine state at the start of the event (before primary generation) is
+// written to <name>_run<r>_evt<e>.rndm and its primary kinematics to
+// <name>.out. The same macro, run sequentially with
+// /testem/watchdog/replay <file> before a /run/beamOn 1, repeats the event.
+// The state file starts with the event number seen by the generator, which
+// the replay restores as its event offset: raster and lane positions are
+// those of the original event.
+//
+// Aborted events stay in the event count: the primary is tracked first, so
+// its transmission is decided before the secondaries that exhaust a budget.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef EventWatchdog_h
+#define EventWatchdog_h 1
+
+#include "globals.hh"
+#include <chrono>
+
+class G4Run;
+class G4Event;
+class WatchdogMessenger;
+
+class EventWatchdog
+{
+  public:
+    EventWatchdog();
+   ~EventWatchdog();
+
+  public:
+    // zero means no limit
+    void SetMaxSteps(G4long val)            {fMaxSteps = val;};
+    void SetMaxTime(G4double val)           {fMaxTime = val;};
+    void SetFileName(const G4String& val)   {fFileName = val;};
+    const G4String& GetFileName() const     {return fFileName;};
+    // engine state restored at the start of the next sequential run
+    void SetReplay(const G4String& val)     {fReplayFile = val;};
+    // a budget is set for the current run
+    G4bool IsActive() const                 {return fActive;};
+
+    // eventOffset: events of the run done before it started (checkpoint)
+    void BeginOfRun(const G4Run*, G4int eventOffset);
+    // event number to generate in the replay run, or -1
+    G4int GetReplayedEvent() const          {return fReplayedEvent;};
+    void BeginOfEvent();
+    inline void Step();
+    void EndOfEvent(const G4Event*);
+    // summary of the run, by the thread that writes the results
+    void EndOfRun();
+
+    void Merge(const EventWatchdog&);
+
+  private:
+    enum Reason {kNone = 0, kSteps, kTime};
+
+    void Abort(Reason);
+    G4double Elapsed() const;
+
+    WatchdogMessenger* fMessenger;
+
+    G4long   fMaxSteps;
+    G4double fMaxTime;       // s of wall time
+    G4String fFileName;
+    G4String fReplayFile;
+    G4bool   fActive;
+    G4int    fEventOffset;
+    G4int    fReplayedEvent;
+
+    // current event
+    G4long   fSteps;
+    Reason   fReason;
+    std::chrono::steady_clock::time_point fStart;
+
+    // aborted events of the run
+    G4int    fAbortedBySteps;
+    G4int    fAbortedByTime;
+};
+
+inline void EventWatchdog::Step()
+{
+  // steps of tracks being killed after an abort are not counted
+  if (!fActive || fReason != kNone) return;
+  ++fSteps;
+  if (fMaxSteps > 0 && fSteps > fMaxSteps) Abort(kSteps);
+  // the clock is read every 256 steps only
+  else if (fMaxTime > 0. && (fSteps & 255) == 0 && Elapsed() > fMaxTime)
+    Abort(kTime);
+}
+
+#endif
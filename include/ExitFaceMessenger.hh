@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ExitFaceMessenger.hh
+/// \brief Definition of the ExitFaceMessenger class
+//
+
+#ifndef ExitFaceMessenger_h
+#define ExitFaceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class ExitFaceScorer;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+class ExitFaceMessenger: public G4UImessenger
+{
+  public:
+  
+    ExitFaceMessenger(ExitFaceScorer* );
+   ~ExitFaceMessenger();
+
+    virtual    
+    void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+  
+    ExitFaceScorer*            fScorer;
+    
+    G4UIdirectory*             fExitDir;
+    G4UIcmdWithABool*          fActiveCmd;
+    G4UIcmdWithAnInteger*      fNbinsECmd;
+    G4UIcmdWithAnInteger*      fNbinsACmd;
+    G4UIcmdWithADoubleAndUnit* fEmaxCmd;
+};
+
+#endif
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ExitFaceScorer.hh
+/// \brief Definition of the ExitFaceScorer class
+//
+// Scores every particle leaving the slab into the world: energy and angle
+// histograms per species on the downstream face, backscatter counts on the
+// upstream face. Histograms are flat arrays allocated once per run, so a hit
+// is a few index computations and additions.
+//
+// From the same run it derives the broad-beam transmission and the number
+// and energy buildup factors relative to the uncollided (narrow-beam) count.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ExitFaceScorer_h
+#define ExitFaceScorer_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+#include <iosfwd>
+#include <cmath>
+#include <algorithm>
+
+class G4ParticleDefinition;
+class ExitFaceMessenger;
+
+class ExitFaceScorer
+{
+  public:
+    enum Species {kGamma = 0, kElectron, kPositron, kOther, kNumberOfSpecies};
+
+    ExitFaceScorer();
+   ~ExitFaceScorer();
+
+  public:
+    void SetActive(G4bool val)           {fActive = val;};
+    G4bool IsActive() const              {return fActive;};
+    void SetNumberOfEnergyBins(G4int n)  {fNbinsE = n;};
+    void SetNumberOfAngleBins(G4int n)   {fNbinsA = n;};
+    // upper edge of the energy histograms, 0 = primary energy
+    void SetMaxEnergy(G4double val)      {fMaxEnergy = val;};
+
+    // allocate and clear the histograms for a new run
+    void Reset(G4double primaryEnergy);
+    void Merge(const ExitFaceScorer&);
+    // histograms of the current run as text, for checkpoints
+    void WriteState(std::ostream&) const;
+    G4bool ReadState(std::istream&);
+
+    // particle crossing from the slab into the world
+    inline void Score(const G4ParticleDefinition*, G4double energy,
+                      const G4ThreeVector& direction, G4bool uncollided);
+
+    void Write(G4double numberOfEvents) const;
+
+  private:
+    inline G4int SpeciesIndex(const G4ParticleDefinition*) const;
+
+    ExitFaceMessenger* fMessenger;
+    G4bool   fActive;
+    G4int    fNbinsE;
+    G4int    fNbinsA;
+    G4double fMaxEnergy;
+
+    // run values
+    G4double fEmax;
+    G4double fInvBinE;
+    G4double fInvBinA;
+    const G4ParticleDefinition* fGamma;
+    const G4ParticleDefinition* fElectron;
+    const G4ParticleDefinition* fPositron;
+
+    std::vector<G4double> fEnergyHist;   // [species][energy bin]
+    std::vector<G4double> fAngleHist;    // [species][angle bin]
+    G4double fCount[kNumberOfSpecies];
+    G4double fEnergySum[kNumberOfSpecies];
+    G4double fBackCount[kNumberOfSpecies];
+    G4double fUncollided;
+    G4double fUncollidedEnergy;
+};
+
+inline G4int ExitFaceScorer::SpeciesIndex(const G4ParticleDefinition* particle) const
+{
+  if (particle == fGamma)    return kGamma;
+  if (particle == fElectron) return kElectron;
+  if (particle == fPositron) return kPositron;
+  return kOther;
+}
+
+inline void ExitFaceScorer::Score(const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4ThreeVector& direction,
+                                  G4bool uncollided)
+{
+  G4int species = SpeciesIndex(particle);
+
+  // the beam goes along +x: anything going back left the upstream face
+  if (direction.x() <= 0.) {
+    fBackCount[species] += 1.;
+    return;
+  }
+
+  fCount[species] += 1.;
+  fEnergySum[species] += energy;
+  if (uncollided) {
+    fUncollided += 1.;
+    fUncollidedEnergy += energy;
+  }
+
+  G4int binE = (G4int)(energy*fInvBinE);
+  if (binE >= fNbinsE) binE = fNbinsE-1;
+  fEnergyHist[species*fNbinsE + binE] += 1.;
+
+  // polar angle to the beam axis, 0-90 deg
+  G4int binA = (G4int)(std::acos(std::min(direction.x(), 1.))*fInvBinA);
+  if (binA >= fNbinsA) binA = fNbinsA-1;
+  fAngleHist[species*fNbinsA + binA] += 1.;
+}
+
+#endif
@@ -0,0 +1,122 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ExpectedValueEstimator.hh
+/// \brief Definition of the ExpectedValueEstimator class
+//
+// Expected-value estimate of the uncollided transmission. Each primary
+// scores exp(-tau), the probability to leave the slab uncollided, instead
+// of the 0/1 of the counting estimator. The optical depth tau is updated at
+// every step of the primary in the slab while it is uncollided: the
+// Sigma l of the steps taken, plus Sigma times the distance to the exit of
+// the current volume (DistanceToOut of its solid, in local coordinates),
+// with Sigma the macroscopic cross section of the tracking tables in the
+// material of the step. The score is the probability of the count given the
+// state of the primary, so both estimators have the same mean; this one has
+// no binomial variance. Reported next to the counting estimator as a
+// cross-check of the transport.
+//
+// Homogeneous slab or lanes only, one volume along the beam: the estimator
+// stays off in CT phantom runs. Gamma beams only, Sigma is electromagnetic.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ExpectedValueEstimator_h
+#define ExpectedValueEstimator_h 1
+
+#include "globals.hh"
+#include "AttenuationCalculator.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include <iosfwd>
+#include <map>
+#include <utility>
+
+class G4Material;
+class G4ParticleDefinition;
+class G4VPhysicalVolume;
+class DetectorConstruction;
+class ExpectedValueMessenger;
+
+class ExpectedValueEstimator
+{
+  public:
+    ExpectedValueEstimator(DetectorConstruction*);
+   ~ExpectedValueEstimator();
+
+  public:
+    void SetActive(G4bool val)  {fRequested = val;};
+    // requested, and possible in the geometry of the current run
+    G4bool IsActive() const     {return fActive;};
+
+    void BeginOfRun(const G4ParticleDefinition*);
+    void BeginOfEvent()
+      {fEvents += 1.; fCollided = false; fDepth = 0.; fScore = 0.;};
+    // updates the score at every step of the uncollided primary in the slab
+    inline void Step(const G4Step*, const G4VPhysicalVolume* world);
+    void EndOfEvent()           {fSum += fScore; fSum2 += fScore*fScore;};
+    // report next to the counting estimator, by the thread that writes
+    // the results
+    void EndOfRun(G4double energy, G4double transmitted, G4double events);
+
+    void Merge(const ExpectedValueEstimator&);
+
+    // tallies of the run, for the checkpoint
+    void WriteState(std::ostream&) const;
+    G4bool ReadState(std::istream&);
+
+  private:
+    void Score(const G4Step*);
+
+    DetectorConstruction*   fDetector;
+    ExpectedValueMessenger* fMessenger;
+    AttenuationCalculator   fCalculator;
+
+    G4bool fRequested;
+    G4bool fActive;
+
+    // Sigma per material and energy, for the current run
+    std::map<std::pair<const G4Material*, G4double>, G4double> fSigma;
+
+    // current event: primary collided, Sigma l of its steps in the slab,
+    // and its score
+    G4bool   fCollided;
+    G4double fDepth;
+    G4double fScore;
+
+    // tallies of the run
+    G4double fEvents;
+    G4double fSum;
+    G4double fSum2;
+};
+
+inline void ExpectedValueEstimator::Step(const G4Step* step,
+                                         const G4VPhysicalVolume* world)
+{
+  if (fCollided || step->GetTrack()->GetParentID() != 0 ||
+      step->GetPreStepPoint()->GetPhysicalVolume() == world) return;
+  Score(step);
+}
+
+#endif
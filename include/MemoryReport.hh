@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/MemoryReport.hh
+/// \brief Definition of the MemoryReport class
+//
+// Memory used by the job, to size batch slots and to compare physics
+// options: current and peak RSS, an estimate of the EM physics tables per
+// particle, process and material, the geometry stores and the high-water
+// mark of the track stack. One section per report in MemoryReport.out,
+// after initialization (start of a run, tables built) and at end of run.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef MemoryReport_h
+#define MemoryReport_h 1
+
+#include "globals.hh"
+#include <iosfwd>
+
+class DetectorConstruction;
+class MemoryMessenger;
+
+class MemoryReport
+{
+  public:
+    MemoryReport(DetectorConstruction*);
+   ~MemoryReport();
+
+  public:
+    void SetActive(G4bool val)            {fActive = val;};
+    G4bool IsActive() const               {return fActive;};
+    void SetFileName(const G4String& val) {fFileName = val;};
+
+    // reports are written by the master thread
+    void BeginOfRun(G4int runID);
+    void EndOfRun(G4int runID);
+    // write a section now
+    void Report(const G4String& label);
+
+    // tracks waiting in the stack, from the stacking action
+    void UpdateStack(G4int nTracks)
+    { if (nTracks > fStackHighWater) fStackHighWater = nTracks; };
+    // highest stack of the worker threads
+    void MergeStack(const MemoryReport& other)
+    { UpdateStack(other.fStackHighWater); };
+
+  private:
+    void WriteProcessMemory(std::ostream&) const;
+    void WriteEmTables(std::ostream&) const;
+    void WriteGeometry(std::ostream&) const;
+
+    DetectorConstruction* fDetector;
+    MemoryMessenger*      fMessenger;
+
+    G4bool   fActive;
+    G4String fFileName;
+    G4bool   fFileStarted;
+    G4int    fStackHighWater;
+};
+
+#endif
@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/MixtureEngine.hh
+/// \brief Definition of the MixtureEngine class
+//
+// Mass attenuation of arbitrary compounds by the mixture rule,
+// mu/rho = sum_i w_i (mu/rho)_i, without building a G4Material per
+// candidate. The per-element (mu/rho)_i of the active physics list are
+// computed once on a log energy grid and stored one element per row, energy
+// contiguous, so a composition is a few scaled row additions.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef MixtureEngine_h
+#define MixtureEngine_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class PrimaryGeneratorAction;
+class MixtureEngineMessenger;
+class AttenuationCalculator;
+class G4ParticleDefinition;
+
+class MixtureEngine
+{
+  public:
+    MixtureEngine(PrimaryGeneratorAction*);
+   ~MixtureEngine();
+
+  public:
+    // elements Z and mass fractions of one compound
+    struct Composition
+    {
+      G4String              name;
+      std::vector<G4int>    Z;
+      std::vector<G4double> fraction;
+    };
+
+    void SetEnergyMin(G4double);
+    void SetEnergyMax(G4double);
+    void SetNumberOfPoints(G4int);
+
+    // one compound per line: "name symbol fraction [symbol fraction ...]";
+    // mu/rho of each on the grid is written to MixtureAttenuation.out
+    void ProcessFile(const G4String&);
+
+    // mu/rho at every grid energy; the element rows must be built
+    void Evaluate(const Composition&, G4double* muOverRho) const;
+
+    const std::vector<G4double>& GetEnergies() const {return fEnergies;};
+
+  private:
+    G4bool ParseLine(const G4String& line, Composition&) const;
+    void ResetTables();
+    void BuildElement(G4int Z);
+
+    PrimaryGeneratorAction* fPrimary;
+    MixtureEngineMessenger* fMessenger;
+    AttenuationCalculator*  fCalculator;
+
+    G4double fEnergyMin;
+    G4double fEnergyMax;
+    G4int    fNumberOfPoints;
+
+    // grid and particle the rows were computed for
+    std::vector<G4double>       fEnergies;
+    const G4ParticleDefinition* fTableParticle;
+    // (mu/rho)_Z at fEnergies[i] is fTable[(Z-1)*nE + i]
+    std::vector<G4double>       fTable;
+    std::vector<G4bool>         fRowBuilt;
+};
+
+#endif
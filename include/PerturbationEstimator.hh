@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/PerturbationEstimator.hh
+/// \brief Definition of the PerturbationEstimator class
+//
+// Transmission and mu/rho of perturbed slabs from the histories of the
+// nominal one. An uncollided primary with path L in the slab has, in a slab
+// of macroscopic cross section Sigma' instead of Sigma, the likelihood ratio
+//   w = exp(-(Sigma' - Sigma) L)
+// and a collided one has weight zero: the perturbed transmission is the
+// mean of w over all events, with the variance of that mean. Every
+// perturbation is scored on the same events, so the differences to the
+// nominal result are much more precise than separate runs would give.
+//
+// A perturbation is a density factor, Sigma' = f Sigma, or a change of the
+// mass fractions at the same density, Sigma' = rho sum_i w'_i (mu/rho)_i
+// (mixture rule, elements from the NIST database). Sigma and Sigma' both
+// come from the mixture rule on the model cross sections, so that a null
+// perturbation has weight one exactly. They are tabulated at the energies
+// of the beam at the start of the run, by the master before the workers
+// start, and the workers copy the tables. The process of the first
+// interaction of the collided primaries is counted for the report.
+//
+// Homogeneous slab only: the estimator stays off in CT phantom and
+// multi-lane runs. Large perturbations (|Sigma' - Sigma| L >> 1) give
+// weights of large variance.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PerturbationEstimator_h
+#define PerturbationEstimator_h 1
+
+#include "globals.hh"
+#include "AttenuationCalculator.hh"
+#include <iosfwd>
+#include <map>
+#include <utility>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4VProcess;
+class G4Material;
+class DetectorConstruction;
+class PerturbationMessenger;
+
+class PerturbationEstimator
+{
+  public:
+    PerturbationEstimator(DetectorConstruction*);
+   ~PerturbationEstimator();
+
+  public:
+    // density times factor
+    void AddDensity(G4double factor);
+    // mass fraction of element Z changed by delta in the perturbation of
+    // this name; repeated for several elements, renormalized to one
+    void AddComposition(const G4String& name, G4int Z, G4double delta);
+    void Clear();
+
+    G4bool IsActive() const {return fActive;};
+
+    // the energies the beam can have in this run; a worker takes the
+    // tables of the master instead of building them
+    void BeginOfRun(const G4ParticleDefinition*,
+                    const std::vector<G4double>& energies,
+                    const PerturbationEstimator* master);
+    void BeginOfEvent();
+    // first interaction of the primary in the slab
+    void CountInteraction(const G4VProcess*);
+    // uncollided primary leaving the slab after a path length in it
+    void ScoreUncollided(const G4ParticleDefinition*, G4double energy,
+                         G4double path);
+    // report and output file, by the thread that writes the results
+    void EndOfRun();
+
+    void Merge(const PerturbationEstimator&);
+
+    // tallies of the run, for the checkpoint
+    void WriteState(std::ostream&) const;
+    G4bool ReadState(std::istream&);
+
+  private:
+    struct Perturbation {
+      G4String name;
+      G4double densityFactor;
+      // (Z, change of mass fraction)
+      std::vector<std::pair<G4int,G4double> > deltas;
+    };
+
+    // Sigma' - Sigma of every perturbation at this energy
+    const std::vector<G4double>& DeltaSigma(const G4ParticleDefinition*,
+                                            G4double energy);
+    std::vector<G4double> ComputeDeltaSigma(const G4ParticleDefinition*,
+                                            G4double energy);
+    // mass fractions of the slab material and of a perturbed one, by Z
+    std::map<G4int,G4double> NominalFractions() const;
+    std::map<G4int,G4double> Fractions(const Perturbation&) const;
+
+    DetectorConstruction*  fDetector;
+    PerturbationMessenger* fMessenger;
+    AttenuationCalculator  fCalculator;
+
+    std::vector<Perturbation> fPerturbations;
+    G4bool fActive;
+
+    // per run: slab material, its elements as pure materials, the mass
+    // fractions, nominal and of every perturbation, and Sigma' - Sigma
+    // per energy
+    const G4Material* fMaterial;
+    std::map<G4int, const G4Material*> fElements;
+    std::map<G4int,G4double> fNominal;
+    std::vector<std::map<G4int,G4double> > fFractions;
+    std::map<G4double, std::vector<G4double> > fDeltaSigma;
+
+    // tallies of the run
+    G4double fEvents;
+    G4bool   fInteracted;
+    G4double fTransmitted;
+    std::vector<G4double> fSumW;
+    std::vector<G4double> fSumW2;
+    std::map<G4String, G4double> fInteractions;
+};
+
+#endif
@@ -34,15 +34,19 @@
 #define PhysicsList_h 1
 
 #include "G4VModularPhysicsList.hh"
+#include "G4ParticleDefinition.hh"
 #include "globals.hh"
+#include <map>
+#include <vector>
 
 class PhysicsListMessenger;
+class DetectorConstruction;
 class G4VPhysicsConstructor;
 
 class PhysicsList: public G4VModularPhysicsList
 {
   public:
-    PhysicsList();
+    PhysicsList(DetectorConstruction*);
    ~PhysicsList();
    
     virtual void ConstructParticle();
@@ -55,18 +59,63 @@ class PhysicsList: public G4VModularPhysicsList
     void SetCutForGamma(G4double);
     void SetCutForElectron(G4double);
     void SetCutForPositron(G4double);
+
+    // cuts of one region ("Target" or "World"), for gamma, e-, e+ or all;
+    // the particles not set keep the global cut
+    void SetRegionCut(const G4String& region, const G4String& particle,
+                      G4double cut);
+
+    // secondaries below these kinetic energies are killed when stacked
+    void SetKillThreshold(const G4String& particle, G4double energy);
+    inline G4double GetKillThreshold(const G4ParticleDefinition*) const;
+    G4bool HasKillThresholds() const
+      {return fKillGamma > 0. || fKillElectron > 0. || fKillPositron > 0.;};
+
+    const G4String& GetEmName() const {return fEmName;};
+    // neutron and ion attenuation need hadronic constructors as well
+    G4bool HasHadronPhysics() const;
+    G4double GetCutForGamma() const    {return fCutForGamma;};
+    G4double GetCutForElectron() const {return fCutForElectron;};
+    G4double GetCutForPositron() const {return fCutForPositron;};
       
   private:
     G4double fCutForGamma;
     G4double fCutForElectron;
     G4double fCutForPositron;
     G4double fCurrentDefaultCut;
+
+    void ApplyRegionCuts();
+    // gamma, e-, e+; negative for the global cut
+    std::map<G4String, std::vector<G4double> > fRegionCuts;
+
+    G4double fKillGamma;
+    G4double fKillElectron;
+    G4double fKillPositron;
     
     G4VPhysicsConstructor*  fEmPhysicsList;
     G4String                fEmName;
+
+    // optional hadronic constructors, one per slot
+    G4VPhysicsConstructor*  fHadronElastic;
+    G4VPhysicsConstructor*  fHadronInelastic;
+    G4VPhysicsConstructor*  fIonInelastic;
     
+    // the fast simulation of the slab, when chosen, needs its process
+    DetectorConstruction*   fDetector;
+
     PhysicsListMessenger*   fMessenger;         
 };
 
+inline G4double
+PhysicsList::GetKillThreshold(const G4ParticleDefinition* particle) const
+{
+  switch (particle->GetPDGEncoding()) {
+    case  22: return fKillGamma;
+    case  11: return fKillElectron;
+    case -11: return fKillPositron;
+    default:  return 0.;
+  }
+}
+
 #endif
 
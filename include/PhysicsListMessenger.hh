@@ -41,6 +41,7 @@ class PhysicsList;
 class G4UIdirectory;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithAString;
+class G4UIcommand;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -64,6 +65,8 @@ class PhysicsListMessenger: public G4UImessenger
     G4UIcmdWithADoubleAndUnit* fProtoCutCmd;    
     G4UIcmdWithADoubleAndUnit* fAllCutCmd;
     G4UIcmdWithAString*        fListCmd;
+    G4UIcommand*               fRegionCutCmd;
+    G4UIcommand*               fKillCmd;
     
 };
 
@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/PointScheduler.hh
+/// \brief Definition of the PointScheduler class
+//
+// Runs a list of independent (material, energy, thickness) points on a pool
+// of worker processes. The geometry and the material-cuts couples of Geant4
+// are global to a process, so points cannot share one; each worker is a
+// fork of the initialised sequential job and takes the next free point
+// whenever it finishes one, so cheap and expensive points balance out. The
+// random engine of a point is seeded from (seed, point index) and does not
+// depend on the worker that ran it. The tallies of each point come back
+// through shared memory and are written in the order of the list, as soon
+// as every point before them is done; the points of a worker that died are
+// reported, and the others written, when the pool has ended.
+//
+// A worker writes no checkpoint; its progress and slow-event files carry
+// the worker number.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PointScheduler_h
+#define PointScheduler_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class PrimaryGeneratorAction;
+class PointSchedulerMessenger;
+
+class PointScheduler
+{
+  public:
+    PointScheduler(DetectorConstruction*, PrimaryGeneratorAction*);
+   ~PointScheduler();
+
+  public:
+    void AddPoint(const G4String& material, G4double energy, G4double thickness);
+    void ClearPoints()                     {fPoints.clear();};
+    void SetEventsPerPoint(G4int val)      {fEventsPerPoint = val;};
+    // zero: one per online cpu
+    void SetNumberOfWorkers(G4int val)     {fNumberOfWorkers = val;};
+    // positive: zero would end the seed array of the engine
+    void SetSeed(G4long val);
+
+    void Run();
+
+  private:
+    struct Point
+    {
+      G4String material;
+      G4double energy;
+      G4double thickness;
+    };
+    // tallies of one point, and the pool state, in shared memory
+    struct Slot;
+    struct Shared;
+
+    void RunWorker(Shared*, G4int worker);
+    void Write(G4int index, const Slot&);
+
+    DetectorConstruction*    fDetector;
+    PrimaryGeneratorAction*  fPrimary;
+    PointSchedulerMessenger* fMessenger;
+
+    std::vector<Point> fPoints;
+    G4int  fEventsPerPoint;
+    G4int  fNumberOfWorkers;
+    G4long fSeed;
+};
+
+#endif
@@ -37,13 +37,17 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
 #include "globals.hh"
+#include <vector>
 
 class G4Event;
+class DetectorConstruction;
+class SpectrumSampler;
+class PrimaryGeneratorMessenger;
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    PrimaryGeneratorAction();    
+    PrimaryGeneratorAction(DetectorConstruction*);    
    ~PrimaryGeneratorAction();
 
   public:
@@ -53,9 +57,64 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     G4double GetInitialEnergy();
 
     G4ParticleGun* GetParticleGun() {return fParticleGun;}
+    // energy of this gun and, in MT, of the worker guns at the next run;
+    // drivers looping over runs on the master use this, not the gun
+    void SetEnergyOfAllGuns(G4double);
+
+    // polyenergetic source: energy sampled per event from a tabulated spectrum
+    void LoadSpectrum(const G4String&);
+    void SetUseSpectrum(G4bool);
+    G4bool UseSpectrum()                {return fUseSpectrum;};
+    const SpectrumSampler* GetSpectrum() {return fSpectrum;};
+    G4int GetCurrentBin()               {return fCurrentBin;};
+    // number of primaries drawn in each bin since the last reset
+    const std::vector<G4double>& GetSampledPerBin() {return fSampledPerBin;};
+    void ResetSampledPerBin();
+
+    // pencil-beam raster: event n goes along x through pixel n%(ny*nz)
+    // of a (y,z) grid centred on the beam axis
+    void SetRaster(G4bool val)          {fUseRaster = val;};
+    void SetRasterPixels(G4int ny, G4int nz);
+    void SetRasterPitch(G4double val)   {fRasterPitch = val;};
+    G4bool UseRaster()                  {return fUseRaster;};
+    G4double GetRasterPitch()           {return fRasterPitch;};
+
+    // ray grid of the run: the raster if on, else for the CT phantom one
+    // ray per voxel column drawn uniformly over the face, else one ray
+    // along the centre of each lane (event n in lane n%nLanes); index iy + ny*iz
+    G4int GetRayGridNy();
+    G4int GetRayGridNz();
+    G4int GetCurrentRay()               {return fCurrentRay;};
+    const std::vector<G4double>& GetSampledPerRay() {return fSampledPerRay;};
+    // the ray grid is that of the lanes
+    G4bool UseLanes();
+    void ResetSampledPerRay(G4int nRays);
+
+    // resumed run: counts and raster position of the events already done
+    void RestoreSampled(const std::vector<G4double>& perBin,
+                        const std::vector<G4double>& perRay,
+                        G4int eventOffset);
+    // replayed event: generated at the raster position of the original
+    void SetEventOffset(G4int val)      {fEventOffset = val;};
 
   private:
     G4ParticleGun*             fParticleGun;
+    PrimaryGeneratorMessenger* fMessenger;
+    DetectorConstruction*      fDetector;
+
+    SpectrumSampler*           fSpectrum;
+    G4bool                     fUseSpectrum;
+    G4int                      fCurrentBin;
+    std::vector<G4double>      fSampledPerBin;
+
+    G4bool                     fUseRaster;
+    G4int                      fRasterNy;
+    G4int                      fRasterNz;
+    G4double                   fRasterPitch;
+
+    G4int                      fCurrentRay;
+    std::vector<G4double>      fSampledPerRay;
+    G4int                      fEventOffset;
 };
 #endif
 
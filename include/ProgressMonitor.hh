@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ProgressMonitor.hh
+/// \brief Definition of the ProgressMonitor class
+//
+// Progress of a long run for batch schedulers: at most once per interval
+// of wall time, one status line with events done, events/s, transmitted
+// fraction, mu +- sigma and the time to completion goes to G4cout and
+// replaces the content of a small status file. With worker threads the
+// counts are summed over threads and one thread writes each report.
+// mu is left out for lanes and the phantom, which have no single slab.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ProgressMonitor_h
+#define ProgressMonitor_h 1
+
+#include "globals.hh"
+#include <atomic>
+#include <chrono>
+
+class G4Run;
+class RunAction;
+class DetectorConstruction;
+class ProgressMessenger;
+
+class ProgressMonitor
+{
+  public:
+    ProgressMonitor(RunAction*, DetectorConstruction*);
+   ~ProgressMonitor();
+
+  public:
+    void SetActive(G4bool val)            {fActive = val;};
+    void SetInterval(G4double val)        {fInterval = val;};
+    void SetFileName(const G4String& val) {fFileName = val;};
+    const G4String& GetFileName() const   {return fFileName;};
+
+    // eventsDone: events restored from a checkpoint
+    void BeginOfRun(const G4Run*, G4int eventsDone);
+    void EndOfEvent();
+    void EndOfRun();
+
+  private:
+    void Report(G4bool final);
+
+    RunAction*            fRunAction;
+    DetectorConstruction* fDetector;
+    ProgressMessenger*    fMessenger;
+
+    G4bool   fActive;
+    G4double fInterval;      // s of wall time between two reports
+    G4String fFileName;
+
+    G4int    fRunID;
+    // transmitted count of this thread already added to the shared sum
+    G4long   fTransmittedAdded;
+
+    // shared by the threads, reset by the master at start of run
+    static std::atomic<G4long> fEventsRequested;
+    static std::atomic<G4long> fEventsDone;
+    static std::atomic<G4long> fEventsAtStart;
+    static std::atomic<G4long> fTransmitted;
+    static std::atomic<std::chrono::steady_clock::rep> fStart;
+    static std::atomic<std::chrono::steady_clock::rep> fNextReport;
+};
+
+#endif
@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/RayCastProjector.hh
+/// \brief Definition of the RayCastProjector class
+//
+// Analytic transmission images: one straight ray per detector pixel is
+// navigated through the current geometry, the path length in each material
+// is accumulated and combined with mu(E) into T = exp(-sum mu*l).
+// No physics is simulated. Rows of the image are shared among threads.
+//
+// Output: <name>.raw, float32 images (one per energy, y fastest, then z),
+//         and <name>.hdr describing them. A ray that gets stuck on a
+//         boundary is not extrapolated: its pixels are NaN and the number
+//         of such rays is reported at the end of the projection.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef RayCastProjector_h
+#define RayCastProjector_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+#include <atomic>
+
+class G4VPhysicalVolume;
+class G4Navigator;
+class RayCastProjectorMessenger;
+
+class RayCastProjector
+{
+  public:
+    RayCastProjector();
+   ~RayCastProjector();
+
+  public:
+    void SetNumberOfPixelsY(G4int val)      {fNy = val;};
+    void SetNumberOfPixelsZ(G4int val)      {fNz = val;};
+    void SetPixelPitch(G4double val)        {fPitch = val;};
+    // 0 = parallel beam along +x, otherwise point source on the x axis
+    void SetSourceDistance(G4double val)    {fSourceDistance = val;};
+    void SetDetectorPosition(G4double val)  {fDetectorX = val;};
+    void AddEnergy(G4double val)            {fEnergies.push_back(val);};
+    void ClearEnergies()                    {fEnergies.clear();};
+    void SetNumberOfThreads(G4int val)      {fNumberOfThreads = val;};
+    void SetFileName(const G4String& val)   {fFileName = val;};
+
+    void Project();
+
+  private:
+    // thread body: takes image rows until none is left
+    void ProjectRows(std::atomic<G4int>& nextRow,
+                     std::atomic<G4int>& stuckRays);
+    // returns false if the ray got stuck before reaching the detector
+    G4bool TraceRay(G4int iy, G4int iz, G4Navigator&,
+                  std::vector<G4double>& pathLength,
+                  std::vector<std::size_t>& visited);
+    void Write() const;
+
+    RayCastProjectorMessenger* fMessenger;
+
+    G4int    fNy;
+    G4int    fNz;
+    G4double fPitch;
+    G4double fSourceDistance;
+    G4double fDetectorX;
+    G4int    fNumberOfThreads;
+    G4String fFileName;
+    std::vector<G4double> fEnergies;
+
+    // run values
+    const G4VPhysicalVolume* fWorld;
+    G4double                 fWorldHalfX;
+    std::size_t              fNumberOfMaterials;
+    std::vector<G4double>    fMu;        // [material][energy]
+    std::vector<float>       fImage;     // [energy][z][y]
+};
+
+#endif
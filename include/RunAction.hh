@@ -35,7 +35,10 @@
 #define RunAction_h 1
 
 #include "G4UserRunAction.hh"
+#include "G4Timer.hh"
 #include "globals.hh"
+#include <vector>
+#include <iosfwd>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -43,6 +46,15 @@ class G4Run;
 class DetectorConstruction;
 class PrimaryGeneratorAction;
 class AnalysisManager;
+class ExitFaceScorer;
+class Checkpoint;
+class ProgressMonitor;
+class MemoryReport;
+class EventWatchdog;
+class PerturbationEstimator;
+class ExpectedValueEstimator;
+class SteppingAction;
+class StackingAction;
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 class RunAction : public G4UserRunAction
@@ -55,11 +67,78 @@ class RunAction : public G4UserRunAction
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
     void TransmittedGammaNumber();
+    // transmitted through the lane of this copy number
+    void TransmittedInLane(G4int lane);
+    // primary leaving through the exit side, scattered or not: not removed
+    void PrimarySurvived() {fPrimarySurvived += 1;};
+    // hadron or ion beam: the removal coefficient is scored in this run
+    G4bool IsRemovalRun();
+    ExitFaceScorer* GetExitFaceScorer() {return fExitFaceScorer;};
+    Checkpoint* GetCheckpoint()         {return fCheckpoint;};
+    ProgressMonitor* GetProgressMonitor() {return fProgressMonitor;};
+    MemoryReport* GetMemoryReport()     {return fMemoryReport;};
+    EventWatchdog* GetWatchdog()        {return fWatchdog;};
+    PerturbationEstimator* GetPerturbation() {return fPerturbation;};
+    ExpectedValueEstimator* GetExpectedValue() {return fExpectedValue;};
+    G4double GetTransmitted() const     {return gammaTransmitted;};
+    G4double GetNumberOfEvents() const  {return numberOfEvents;};
+    // every step, for the navigation rate (steps/s) of the run
+    void CountStep() {fNumberOfSteps += 1;};
+    // secondaries below the kill thresholds of the physics list
+    void CountKilledSecondary() {fNumberOfKilled += 1;};
     void GetCuts();
+    // actions specialized at the start of each run for the options in use
+    void SetSteppingAction(SteppingAction* val) {fSteppingAction = val;};
+    void SetStackingAction(StackingAction* val) {fStackingAction = val;};
+    // adds the tallies of a worker run to this one
+    void Merge(const RunAction&);
+    // tallies of the current run, for checkpoints
+    void WriteTallies(std::ostream&) const;
+    G4bool ReadTallies(std::istream&, G4int eventsDone);
                                     
   private:
+    void EndOfSpectrumRun(G4double numberOfEvents);
+    void EndOfRayRun();
+    // neutrons and ions: removal coefficient, Monte Carlo and analytic
+    void EndOfRemovalRun(G4double numberOfEvents);
+
+    // run action of the master thread, which collects the worker tallies
+    static RunAction* fMasterRunAction;
+
     G4double gammaTransmitted;
+    G4double fPrimarySurvived;
     G4double numberOfEvents;
+    // transmitted primaries per spectrum bin (polyenergetic source)
+    std::vector<G4double> fBinTransmitted;
+    std::vector<G4double> fBinTotal;
+    // every particle leaving the slab (broad beam, buildup)
+    ExitFaceScorer* fExitFaceScorer;
+    // transmitted primaries per ray (raster pixel or CT phantom column),
+    // indexed directly by the source ray
+    std::vector<G4double> fRayTransmitted;
+    std::vector<G4double> fRayTotal;
+    G4int fRayGridNy;
+
+    // periodic checkpoints; events restored from one when resuming
+    Checkpoint* fCheckpoint;
+    G4int fEventOffset;
+    // status line for batch schedulers
+    ProgressMonitor* fProgressMonitor;
+    // RSS, physics tables, geometry and stack sizes
+    MemoryReport* fMemoryReport;
+    // per-event step and time budgets
+    EventWatchdog* fWatchdog;
+    // perturbed slabs reweighted from the nominal histories
+    PerturbationEstimator* fPerturbation;
+    // exp(-Sigma L) at entry, next to the 0/1 count
+    ExpectedValueEstimator* fExpectedValue;
+
+    SteppingAction* fSteppingAction;
+    StackingAction* fStackingAction;
+
+    G4double fNumberOfSteps;
+    G4double fNumberOfKilled;
+    G4Timer  fTimer;
     DetectorConstruction*   fDetector;
     PrimaryGeneratorAction* fPrimary;
     G4double  fRangeCut[3];
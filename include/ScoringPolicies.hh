@@ -0,0 +1,209 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ScoringPolicies.hh
+/// \brief Scoring policies of the stepping and stacking actions
+//
+// Each scoring option is a policy with an active and an empty variant; the
+// actions are templates over one policy per option, and the combination in
+// use is chosen at the start of each run. A step then runs only the checks
+// of the options switched on, with no test of the others.
+//
+//   beam          NarrowBeam: uncollided primaries counted for the slab
+//                 LaneBeam: counted per lane (multi-lane geometry)
+//   exit face     NoExitFace, BroadBeam: everything leaving the slab
+//   interactions  NoInteractions, ProcessResolved: first interaction of the
+//                 primaries and reweighting of the perturbed slabs
+//   budget        NoBudget, EventBudget: per-event step and time limits
+//   estimator     NoExpectedValue, ExpectedValue: exp(-tau) along the path
+//   removal       NoRemoval, RemovalBeam: hadron and ion primaries leaving
+//                 through the exit face, for the removal coefficient
+//   kill          NoKill, KillBelowThreshold: secondaries under threshold
+//   stack         NoStackWatch, StackWatch: stack size for the memory report
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ScoringPolicies_h
+#define ScoringPolicies_h 1
+
+#include "RunAction.hh"
+#include "ExitFaceScorer.hh"
+#include "PerturbationEstimator.hh"
+#include "EventWatchdog.hh"
+#include "ExpectedValueEstimator.hh"
+#include "MemoryReport.hh"
+#include "PhysicsList.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VTouchable.hh"
+#include "G4VSolid.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4VProcess.hh"
+#include "G4StackManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NarrowBeam
+{
+  static void Transmitted(RunAction* run, const G4Step*)
+  { run->TransmittedGammaNumber(); }
+};
+
+struct LaneBeam
+{
+  // the lane is known from where the primary leaves
+  static void Transmitted(RunAction* run, const G4Step* step)
+  { run->TransmittedInLane(
+      step->GetPreStepPoint()->GetTouchableHandle()->GetCopyNumber()); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoExitFace
+{
+  static void Score(ExitFaceScorer*, const G4Track*, G4bool) {}
+};
+
+struct BroadBeam
+{
+  static void Score(ExitFaceScorer* scorer, const G4Track* track,
+                    G4bool uncollided)
+  { scorer->Score(track->GetDefinition(), track->GetKineticEnergy(),
+                  track->GetMomentumDirection(), uncollided); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoInteractions
+{
+  static void Step(PerturbationEstimator*, const G4Step*,
+                   const G4VPhysicalVolume*) {}
+  static void Uncollided(PerturbationEstimator*, const G4Track*, G4double) {}
+};
+
+struct ProcessResolved
+{
+  // any step of a primary in the slab that is not a boundary crossing
+  static void Step(PerturbationEstimator* estimator, const G4Step* step,
+                   const G4VPhysicalVolume* world)
+  {
+    if (step->GetTrack()->GetParentID() != 0 ||
+        step->GetPreStepPoint()->GetPhysicalVolume() == world) return;
+    const G4VProcess* process = step->GetPostStepPoint()->GetProcessDefinedStep();
+    if (process && process->GetProcessType() != fTransportation)
+      estimator->CountInteraction(process);
+  }
+
+  static void Uncollided(PerturbationEstimator* estimator,
+                         const G4Track* track, G4double path)
+  { estimator->ScoreUncollided(track->GetDefinition(),
+                               track->GetKineticEnergy(), path); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoBudget
+{
+  static void Step(EventWatchdog*) {}
+};
+
+struct EventBudget
+{
+  static void Step(EventWatchdog* watchdog) { watchdog->Step(); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoExpectedValue
+{
+  static void Step(ExpectedValueEstimator*, const G4Step*,
+                   const G4VPhysicalVolume*) {}
+};
+
+struct ExpectedValue
+{
+  static void Step(ExpectedValueEstimator* estimator, const G4Step* step,
+                   const G4VPhysicalVolume* world)
+  { estimator->Step(step, world); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoRemoval
+{
+  static void Exit(RunAction*, const G4Step*) {}
+};
+
+struct RemovalBeam
+{
+  // a primary not removed by an inelastic interaction, leaving through
+  // the exit face and not a lateral one
+  static void Exit(RunAction* run, const G4Step* step)
+  {
+    const G4Track* track = step->GetTrack();
+    if (track->GetParentID() != 0 || track->GetMomentumDirection().x() <= 0.)
+      return;
+    const G4StepPoint* point = step->GetPreStepPoint();
+    const G4AffineTransform& transform =
+      point->GetTouchableHandle()->GetHistory()->GetTopTransform();
+    G4ThreeVector exit =
+      transform.TransformPoint(step->GetPostStepPoint()->GetPosition());
+    G4VSolid* solid = point->GetPhysicalVolume()->GetLogicalVolume()->GetSolid();
+    if (solid->SurfaceNormal(exit).x() > 0.5) run->PrimarySurvived();
+  }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoKill
+{
+  static G4bool Killed(const PhysicsList*, const G4Track*) { return false; }
+};
+
+struct KillBelowThreshold
+{
+  static G4bool Killed(const PhysicsList* physics, const G4Track* track)
+  { return track->GetParentID() > 0 && track->GetKineticEnergy() <
+           physics->GetKillThreshold(track->GetDefinition()); }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct NoStackWatch
+{
+  static void Update(MemoryReport*, G4StackManager*) {}
+};
+
+struct StackWatch
+{
+  // the new track is not in the stack yet
+  static void Update(MemoryReport* memory, G4StackManager* stack)
+  { memory->UpdateStack(stack->GetNTotalTrack() + 1); }
+};
+
+#endif
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/SlabFastSimModel.hh
+/// \brief Definition of the SlabFastSimModel class
+//
+// Fast simulation of primary gammas entering the slab: the distance to the
+// first interaction is sampled from the total macroscopic cross section of
+// the active physics list. If it is beyond the exit face the photon is moved
+// there unchanged (uncollided); otherwise it is absorbed at the sampled
+// point, its energy deposited there.
+//
+// The uncollided probability exp(-Sigma*x) is reproduced exactly; nothing
+// scattered leaves the slab, so the exit-face scorer is switched off in
+// this mode. The model and its physics exist only when the mode is chosen
+// before initialization (/testem/det/fastSimulation).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef SlabFastSimModel_h
+#define SlabFastSimModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class AttenuationCalculator;
+class G4Material;
+
+class SlabFastSimModel : public G4VFastSimulationModel
+{
+  public:
+    SlabFastSimModel(const G4String&, G4Region*, DetectorConstruction*);
+   ~SlabFastSimModel();
+
+  public:
+    virtual G4bool IsApplicable(const G4ParticleDefinition&);
+    virtual G4bool ModelTrigger(const G4FastTrack&);
+    virtual void DoIt(const G4FastTrack&, G4FastStep&);
+
+  private:
+    G4double CrossSection(G4double energy, const G4Material*);
+
+    DetectorConstruction*  fDetector;
+    AttenuationCalculator* fCalculator;
+
+    // last cross section evaluated
+    G4double          fLastEnergy;
+    const G4Material* fLastMaterial;
+    G4double          fLastSigma;
+};
+
+#endif
@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/SpectrumSampler.hh
+/// \brief Definition of the SpectrumSampler class
+//
+// Tabulated energy spectrum sampled with Walker's alias method: the cost of
+// one sample is two uniform numbers and one table lookup, whatever the
+// number of bins.
+//
+// File format: one "energy(MeV) weight" pair per line, '#' starts a comment.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef SpectrumSampler_h
+#define SpectrumSampler_h 1
+
+#include "globals.hh"
+#include <vector>
+#include <algorithm>
+
+class SpectrumSampler
+{
+  public:
+    SpectrumSampler();
+   ~SpectrumSampler();
+
+  public:
+    G4bool Load(const G4String& fileName);
+
+    // bin index from two uniform numbers in [0,1)
+    inline G4int SampleBin(G4double u1, G4double u2) const;
+
+    G4int    GetNumberOfBins()       const {return (G4int)fEnergy.size();};
+    G4double GetEnergy(G4int bin)    const {return fEnergy[bin];};
+    G4double GetWeight(G4int bin)    const {return fWeight[bin];};
+    G4double GetMeanEnergy()         const;
+    G4double GetMaxEnergy()          const;
+
+  private:
+    void BuildAliasTable();
+
+    std::vector<G4double> fEnergy;
+    std::vector<G4double> fWeight;       // normalised to 1
+    std::vector<G4double> fProbability;  // alias acceptance probability
+    std::vector<G4int>    fAlias;
+};
+
+inline G4int SpectrumSampler::SampleBin(G4double u1, G4double u2) const
+{
+  G4int n = (G4int)fProbability.size();
+  G4int bin = std::min((G4int)(u1*n), n-1);
+  return (u2 < fProbability[bin]) ? bin : fAlias[bin];
+}
+
+#endif
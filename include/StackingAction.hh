@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/StackingAction.hh
+/// \brief Definition of the StackingAction class
+//
+
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+#include <array>
+#include <utility>
+
+class RunAction;
+class PhysicsList;
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction(RunAction*, const PhysicsList*);
+   ~StackingAction();
+
+  public:
+    // kills secondaries below the thresholds of the physics list, else
+    // default classification; records the stack size for the memory report
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track)
+      {return (this->*fClassify)(track);};
+
+    // picks the classification of the next run from the options in use
+    // (ScoringPolicies.hh); called by the run action
+    void BeginOfRun();
+
+  private:
+    typedef G4ClassificationOfNewTrack
+      (StackingAction::*ClassifyFunction)(const G4Track*);
+
+    template <class Kill, class Stack>
+    G4ClassificationOfNewTrack Classify(const G4Track*);
+    // every combination of the policies, indexed by the options
+    template <std::size_t... Options>
+    static std::array<ClassifyFunction, sizeof...(Options)>
+    Table(std::index_sequence<Options...>);
+
+    RunAction*         fRunAction;
+    const PhysicsList* fPhysicsList;
+    ClassifyFunction   fClassify;
+};
+
+#endif
@@ -44,6 +44,8 @@
 #include "G4EventManager.hh"
 #include "G4ios.hh"
 #include "globals.hh"
+#include <array>
+#include <utility>
 
 class G4Step;
 //class Tst50AnalysisManager;
@@ -60,12 +62,27 @@ public:
 
   ~SteppingAction();
 
-  void UserSteppingAction(const G4Step* aStep);
+  // picks the scoring path of the next run from the options in use
+  // (ScoringPolicies.hh); called by the run action
+  void BeginOfRun();
+
+  void UserSteppingAction(const G4Step* aStep) {(this->*fScore)(aStep);};
 
 private:
 
+  typedef void (SteppingAction::*ScoreFunction)(const G4Step*);
+
+  template <class Beam, class ExitFace, class Interactions, class Budget,
+            class Estimator, class Removal>
+  void Score(const G4Step*);
+  // every combination of the policies, indexed by the options
+  template <std::size_t... Options>
+  static std::array<ScoreFunction, sizeof...(Options)>
+  Table(std::index_sequence<Options...>);
+
   PrimaryGeneratorAction* primaryAction;
   RunAction* runAction; 
   DetectorConstruction* detector;     
+  ScoreFunction fScore;
 };
 #endif
@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/TableExporter.hh
+/// \brief Definition of the TableExporter class
+//
+// Writes the analytic mu/rho(E) of a list of materials, for the active
+// physics list, as an AttenuationTable file read by downstream tools.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef TableExporter_h
+#define TableExporter_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class PrimaryGeneratorAction;
+class PhysicsList;
+class TableExporterMessenger;
+class AttenuationCalculator;
+
+class TableExporter
+{
+  public:
+    TableExporter(DetectorConstruction*, PrimaryGeneratorAction*, PhysicsList*);
+   ~TableExporter();
+
+  public:
+    // NIST or user material; none means the slab material
+    void AddMaterial(const G4String& name) {fMaterials.push_back(name);};
+    void ClearMaterials()                  {fMaterials.clear();};
+    void SetEnergyMin(G4double val)        {fEnergyMin = val;};
+    void SetEnergyMax(G4double val)        {fEnergyMax = val;};
+    void SetNumberOfPoints(G4int val)      {fNumberOfPoints = val;};
+    void SetFileName(const G4String& val)  {fFileName = val;};
+
+    void Write();
+
+  private:
+    DetectorConstruction*   fDetector;
+    PrimaryGeneratorAction* fPrimary;
+    PhysicsList*            fPhysicsList;
+    TableExporterMessenger* fMessenger;
+    AttenuationCalculator*  fCalculator;
+
+    std::vector<G4String> fMaterials;
+    G4double fEnergyMin;
+    G4double fEnergyMax;
+    G4int    fNumberOfPoints;
+    G4String fFileName;
+};
+
+#endif
@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/Validation.hh
+/// \brief Definition of the Validation class
+//
+// Compares the Monte Carlo mu/rho with reference tables (e.g. NIST XCOM)
+// stored locally, one file per material. One run is done per reference
+// energy; the pull of each point uses the binomial error of the
+// transmission and an optional relative error of the reference. The job
+// fails if chi2/ndf or the largest |pull| of any material is above its limit.
+//
+// Reference files: energy (MeV) and mu/rho (cm2/g) in whitespace-separated
+// columns, lines starting with # are comments. SetColumn selects the mu/rho
+// column (XCOM: 7 for the total with coherent scattering, which is what the
+// uncollided transmission measures).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef Validation_h
+#define Validation_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class PrimaryGeneratorAction;
+class ValidationMessenger;
+
+class Validation
+{
+  public:
+    Validation(DetectorConstruction*, PrimaryGeneratorAction*);
+   ~Validation();
+
+  public:
+    void AddReference(const G4String& material, const G4String& fileName);
+    void ClearReferences()                 {fReferences.clear();};
+    void SetColumn(G4int val)              {fColumn = val;};
+    void SetEnergyMin(G4double val)        {fEnergyMin = val;};
+    void SetEnergyMax(G4double val)        {fEnergyMax = val;};
+    void SetEventsPerPoint(G4int val)      {fEventsPerPoint = val;};
+    void SetReferenceError(G4double val)   {fReferenceError = val;};
+    void SetMaxChi2(G4double val)          {fMaxChi2 = val;};
+    void SetMaxPull(G4double val)          {fMaxPull = val;};
+    // fail unless run with at least this many worker threads, for the
+    // job that validates the merged MT tallies (0: any run manager)
+    void SetMinThreads(G4int val)          {fMinThreads = val;};
+
+    void Run();
+
+    // one material of the last Run, or a reference file, was out of limits
+    G4bool Failed() const                  {return fFailed;};
+
+  private:
+    struct Reference
+    {
+      G4String material;
+      G4String fileName;
+      std::vector<G4double> energies;
+      std::vector<G4double> mu;
+    };
+
+    G4bool Read(Reference&) const;
+    G4bool RunMaterial(const Reference&);
+
+    DetectorConstruction*   fDetector;
+    PrimaryGeneratorAction* fPrimary;
+    ValidationMessenger*    fMessenger;
+
+    std::vector<Reference> fReferences;
+    G4int    fColumn;
+    G4double fEnergyMin;
+    G4double fEnergyMax;
+    G4int    fEventsPerPoint;
+    G4double fReferenceError;
+    G4double fMaxChi2;        // per degree of freedom
+    G4double fMaxPull;
+    G4int    fMinThreads;
+    G4bool   fFailed;
+};
+
+#endif
@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/ValidationMessenger.hh
+/// \brief Definition of the ValidationMessenger class
+//
+
+#ifndef ValidationMessenger_h
+#define ValidationMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class Validation;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+class ValidationMessenger: public G4UImessenger
+{
+  public:
+  
+    ValidationMessenger(Validation* );
+   ~ValidationMessenger();
+
+    virtual    
+    void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+  
+    Validation*                fValidation;
+    
+    G4UIdirectory*             fValidateDir;
+    G4UIcommand*               fAddRefCmd;
+    G4UIcmdWithoutParameter*   fClearRefCmd;
+    G4UIcmdWithAnInteger*      fColumnCmd;
+    G4UIcmdWithADoubleAndUnit* fEminCmd;
+    G4UIcmdWithADoubleAndUnit* fEmaxCmd;
+    G4UIcmdWithAnInteger*      fEventsCmd;
+    G4UIcmdWithADouble*        fRefErrorCmd;
+    G4UIcmdWithADouble*        fMaxChi2Cmd;
+    G4UIcmdWithADouble*        fMaxPullCmd;
+    G4UIcmdWithAnInteger*      fMinThreadsCmd;
+    G4UIcmdWithoutParameter*   fRunCmd;
+};
+
+#endif
@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/include/WorkerInitialization.hh
+/// \brief Definition of the WorkerInitialization class
+//
+// Placement of the worker threads on multi-socket nodes. Each worker pins
+// itself at start to one CPU of the process affinity mask:
+//   compact  fill a socket before using the next one
+//   scatter  alternate between sockets
+// /testem/threads/socket restricts the master and the workers to one
+// socket. The physics tables are built by the master and shared, so with
+// first-touch allocation they live on the socket of the master: one job
+// per socket, each restricted to it, keeps every table local.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WorkerInitialization_h
+#define WorkerInitialization_h 1
+
+#include "G4UserWorkerInitialization.hh"
+#include "globals.hh"
+#include <vector>
+
+class WorkerMessenger;
+
+class WorkerInitialization : public G4UserWorkerInitialization
+{
+  public:
+    WorkerInitialization();
+   ~WorkerInitialization();
+
+  public:
+    // none, compact or scatter
+    void SetPinning(const G4String&);
+    // -1: all sockets
+    void SetSocket(G4int);
+
+    virtual void WorkerStart() const;
+
+  private:
+    // CPUs allowed to the process, in pinning order
+    std::vector<G4int> PlacementOrder() const;
+
+    WorkerMessenger* fMessenger;
+    G4String fPinning;
+    G4int    fSocket;
+};
+
+#endif
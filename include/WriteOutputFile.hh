@@ -55,14 +55,87 @@ public:
   static WriteOutputFile* GetInstance();
 
   void Fill(G4double, G4double); 
+  // energy points chosen by the adaptive scan
+  void FillEnergyGrid(G4double, G4double, G4double);
+  // per-bin and spectrum-weighted results of a polyenergetic run
+  void FillSpectrumBin(G4double, G4double, G4double, G4double, G4double);
+  void FillSpectrumSummary(G4double, G4double);
+  // per-ray uncollided transmission through the CT phantom
+  void FillRay(G4int, G4int, G4double, G4double, G4double);
+  // mixture-rule mu/rho of a compound at one energy
+  void FillMixture(const G4String&, G4double, G4double);
+  // Monte Carlo against reference mu/rho, and the verdict per material
+  void FillValidation(const G4String&, G4double, G4double, G4double,
+                      G4double, G4double);
+  void FillValidationSummary(const G4String&, G4double, G4int, G4double, G4bool);
+  // mu/rho of each lane of a multi-lane run
+  void FillLane(G4int, const G4String&, G4double, G4double, G4double,
+                G4double, G4double);
+  // one (material, energy, thickness) point of the process pool
+  void FillPoint(const G4String&, G4double, G4double, G4double, G4double,
+                 G4double, G4double);
+  // removal and total mu/rho of neutrons and ions, Monte Carlo and analytic
+  void FillRemoval(const G4String&, G4double, G4double, G4double, G4double,
+                   G4double, G4double);
+  // transmission and mu/rho of a perturbed slab, reweighted from the nominal
+  void FillPerturbation(const G4String&, G4double, G4double, G4double,
+                        G4double, G4double, G4double, G4double);
+  // counting and expected-value transmission of one run
+  void FillExpectedValue(G4double, G4double, G4double, G4double, G4double,
+                         G4double, G4double);
+  // float32 image <name>.raw, y fastest, with its <name>.hdr
+  void WriteImage(const G4String& name, G4int ny, G4int nz, G4double pitch,
+                  const std::vector<float>&);
   void Save();
+  void Flush();
+  // continue the files of an interrupted job instead of truncating them
+  void SetAppend();
+  // nothing is written, in processes whose results go elsewhere
+  void SetSuppressed(G4bool);
 
 private:
 
   static WriteOutputFile* instance;
+
+  G4bool append;
+  G4bool suppressed;
+  // opens for writing or appending; true if the header line is needed
+  G4bool Open(std::ofstream&, const G4String&);
  
   G4String stdFile;
   std::ofstream ofs;
+
+  G4String gridFile;
+  std::ofstream gridOfs;
+
+  G4String spectrumFile;
+  std::ofstream spectrumOfs;
+  void OpenSpectrumFile();
+
+  G4String rayFile;
+  std::ofstream rayOfs;
+
+  G4String mixtureFile;
+  std::ofstream mixtureOfs;
+
+  G4String validationFile;
+  std::ofstream validationOfs;
+  void OpenValidationFile();
+
+  G4String pointFile;
+  std::ofstream pointOfs;
+
+  G4String laneFile;
+  std::ofstream laneOfs;
+
+  G4String removalFile;
+  std::ofstream removalOfs;
+
+  G4String expectedFile;
+  std::ofstream expectedOfs;
+
+  G4String perturbationFile;
+  std::ofstream perturbationOfs;
 };
 #endif
 
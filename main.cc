@@ -36,18 +36,42 @@
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
 #include "PrimaryGeneratorAction.hh"
-#include "RunAction.hh"
-#include "SteppingAction.hh"
+#include "ActionInitialization.hh"
+#include "WorkerInitialization.hh"
+#include "EnergyScan.hh"
+#include "MixtureEngine.hh"
+#include "TableExporter.hh"
+#include "RayCastProjector.hh"
+#include "Validation.hh"
+#include "PointScheduler.hh"
 #include "G4UIExecutive.hh"
+#ifdef G4VIS_USE
 #include "G4VisExecutive.hh"
+#endif
 // ASCII file contains the output of the simulation
 #include "WriteOutputFile.hh"
 #include <unistd.h> 
+#include <cstdlib>
  
 int main(int argc,char** argv) {
     
-  // Construct the  run manager
-  auto* runManager = G4RunManagerFactory::CreateRunManager("Serial");
+  // usage: attenuation [macro] [-t nThreads] [--resume]
+  G4String macroFile;
+  G4int nThreads = 0;
+  G4bool resume = false;
+  for (G4int i = 1; i < argc; ++i) {
+    G4String arg = argv[i];
+    if (arg == "--resume") resume = true;
+    else if (arg == "-t" && i+1 < argc) nThreads = std::atoi(argv[++i]);
+    else macroFile = arg;
+  }
+
+  // Construct the  run manager: sequential unless threads are asked for
+  auto* runManager = G4RunManagerFactory::CreateRunManager(
+    nThreads > 0 ? G4RunManagerType::Default : G4RunManagerType::Serial);
+  G4bool multiThreaded = (nThreads > 0 &&
+    runManager->GetRunManagerType() != G4RunManager::sequentialRM);
+  if (multiThreaded) runManager->SetNumberOfThreads(nThreads);
 
   //CLHEP::HepRandom::setTheEngine(new CLHEP::RanecuEngine());
  // runManager -> SetRandomNumberStore(true);
@@ -60,46 +84,77 @@ int main(int argc,char** argv) {
   // set mandatory initialization classes
   DetectorConstruction* det;
   PrimaryGeneratorAction* prim;
+  PhysicsList* phys;
   runManager->SetUserInitialization(det = new DetectorConstruction);
-  runManager->SetUserInitialization(new PhysicsList);
-  runManager->SetUserAction(prim = new PrimaryGeneratorAction());
+  runManager->SetUserInitialization(phys = new PhysicsList(det));
+  prim = new PrimaryGeneratorAction(det);
   
   // set user action classes
 
   WriteOutputFile* output = WriteOutputFile::GetInstance();
    
-  RunAction* run = new RunAction(det, prim);
-  runManager->SetUserAction(run);
+  runManager->SetUserInitialization(new ActionInitialization(det, prim, phys));
 
-  runManager->SetUserAction(new SteppingAction(prim,run,det));
+  // worker pinning (/testem/threads/), applied by MT run managers only
+  WorkerInitialization* workerInit = new WorkerInitialization();
+  if (multiThreaded) runManager->SetUserInitialization(workerInit);
 
-  // Visualization manager
-  G4VisManager* visManager = new G4VisExecutive;
-  visManager->Initialize();
- 
-  if (argc!=1)   // batch mode   
+  if (resume)
+    G4UImanager::GetUIpointer()->ApplyCommand("/testem/checkpoint/resume true");
+
+  // adaptive energy scan driver (/testem/scan/)
+  EnergyScan* scan = new EnergyScan(det, prim);
+  // mixture-rule mu/rho of compound lists (/testem/mix/)
+  MixtureEngine* mixer = new MixtureEngine(prim);
+  // binary mu/rho tables for downstream tools (/testem/table/)
+  TableExporter* exporter = new TableExporter(det, prim, phys);
+  // analytic transmission images (/testem/proj/)
+  RayCastProjector* projector = new RayCastProjector();
+  // comparison with reference tables (/testem/validate/)
+  Validation* validation = new Validation(det, prim);
+  // independent points on a pool of processes (/testem/points/)
+  PointScheduler* scheduler = new PointScheduler(det, prim);
+
+  if (!macroFile.empty())   // batch mode: no UI session, no vis manager
     {
      G4String command = "/control/execute ";
-     G4String fileName = argv[1];
+     G4String fileName = macroFile;
      G4UImanager::GetUIpointer()->ApplyCommand(command+fileName); 
     }
     
   else           // define UI terminal for interactive mode 
     { 
       G4UIExecutive * ui = new G4UIExecutive(argc,argv);   
+#ifdef G4VIS_USE
+      // Visualization manager, interactive sessions only
+      G4VisManager* visManager = new G4VisExecutive;
+      visManager->Initialize();
       G4UImanager::GetUIpointer()-> ApplyCommand("/control/execute vis.mac");    
+#endif
       ui->SessionStart();
       delete ui;
+#ifdef G4VIS_USE
+      delete visManager;
+#endif
     }
 
-  delete visManager;
-
   output ->  Save();
  
   delete output;
+  // a failed validation is reported to the calling script
+  G4int status = validation->Failed() ? 1 : 0;
+  delete validation;
+  delete scheduler;
+  delete projector;
+  delete exporter;
+  delete mixer;
+  delete scan;
   delete runManager;
+  // owned by the run manager in sequential mode only
+  if (multiThreaded) delete prim;
+  else delete workerInit;
 
-  return 0;
+  return status;
 }
 
 
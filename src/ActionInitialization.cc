@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ActionInitialization.cc
+/// \brief Implementation of the ActionInitialization class
+//
+
+#include "ActionInitialization.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "EventAction.hh"
+#include "StackingAction.hh"
+#include "SteppingAction.hh"
+
+#include "G4Threading.hh"
+
+ActionInitialization::ActionInitialization(DetectorConstruction* det,
+                                           PrimaryGeneratorAction* prim,
+                                           const PhysicsList* phys)
+:G4VUserActionInitialization(),fDetector(det),fMasterPrimary(prim),
+ fPhysicsList(phys)
+{ }
+
+ActionInitialization::~ActionInitialization()
+{ }
+
+void ActionInitialization::BuildForMaster() const
+{
+  // the master only merges the worker tallies and writes the results
+  SetUserAction(new RunAction(fDetector, fMasterPrimary));
+}
+
+void ActionInitialization::Build() const
+{
+  PrimaryGeneratorAction* prim = fMasterPrimary;
+  if (G4Threading::IsWorkerThread()) prim = new PrimaryGeneratorAction(fDetector);
+  SetUserAction(prim);
+
+  RunAction* run = new RunAction(fDetector, prim);
+  SetUserAction(run);
+  SetUserAction(new EventAction(run));
+  StackingAction* stacking = new StackingAction(run, fPhysicsList);
+  SetUserAction(stacking);
+  run->SetStackingAction(stacking);
+  SteppingAction* stepping = new SteppingAction(prim, run, fDetector);
+  SetUserAction(stepping);
+  run->SetSteppingAction(stepping);
+}
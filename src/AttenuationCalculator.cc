@@ -0,0 +1,131 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/AttenuationCalculator.cc
+/// \brief Implementation of the AttenuationCalculator class
+//
+
+#include "AttenuationCalculator.hh"
+
+#include "G4Material.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VProcess.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4HadronicProcessStore.hh"
+
+AttenuationCalculator::AttenuationCalculator()
+{ }
+
+AttenuationCalculator::~AttenuationCalculator()
+{ }
+
+G4double AttenuationCalculator::ComputeCrossSectionPerVolume(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4Material* material)
+{
+  G4ProcessManager* manager = particle->GetProcessManager();
+  if (!manager || !material) return 0.;
+
+  // the cut only matters for the ionisation/brems of charged particles
+  G4double cut = ElectronEnergyCut(material);
+
+  G4double sigma = 0.;
+  G4ProcessVector* processes = manager->GetProcessList();
+  for (std::size_t i = 0; i < processes->size(); ++i) {
+    G4VProcess* process = (*processes)[i];
+    if (process->GetProcessType() != fElectromagnetic) continue;
+    if (process->GetProcessSubType() == fMultipleScattering) continue;
+    sigma += fEmCalculator.ComputeCrossSectionPerVolume(energy, particle,
+                                      process->GetProcessName(),
+                                      material, cut);
+  }
+  return sigma;
+}
+
+G4double AttenuationCalculator::GetCrossSectionPerVolume(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4Material* material)
+{
+  G4ProcessManager* manager = particle->GetProcessManager();
+  if (!manager || !material) return 0.;
+
+  G4double sigma = 0.;
+  G4ProcessVector* processes = manager->GetProcessList();
+  for (std::size_t i = 0; i < processes->size(); ++i) {
+    G4VProcess* process = (*processes)[i];
+    if (process->GetProcessType() != fElectromagnetic) continue;
+    if (process->GetProcessSubType() == fMultipleScattering) continue;
+    sigma += fEmCalculator.GetCrossSectionPerVolume(energy, particle,
+                                      process->GetProcessName(), material);
+  }
+  return sigma;
+}
+
+G4double AttenuationCalculator::ComputeMassAttenuation(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4Material* material)
+{
+  return ComputeCrossSectionPerVolume(particle, energy, material)
+         /material->GetDensity();
+}
+
+G4double AttenuationCalculator::GetRemovalCrossSectionPerVolume(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4Material* material)
+{
+  return G4HadronicProcessStore::Instance()->
+           GetInelasticCrossSectionPerVolume(particle, energy, material);
+}
+
+G4double AttenuationCalculator::GetHadronicCrossSectionPerVolume(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy,
+                                  const G4Material* material)
+{
+  G4HadronicProcessStore* store = G4HadronicProcessStore::Instance();
+  return store->GetInelasticCrossSectionPerVolume(particle, energy, material)
+       + store->GetElasticCrossSectionPerVolume(particle, energy, material)
+       + store->GetCaptureCrossSectionPerVolume(particle, energy, material)
+       + store->GetFissionCrossSectionPerVolume(particle, energy, material);
+}
+
+G4double AttenuationCalculator::ElectronEnergyCut(const G4Material* material)
+{
+  G4ProductionCutsTable* table = G4ProductionCutsTable::GetProductionCutsTable();
+  for (std::size_t i = 0; i < table->GetTableSize(); ++i) {
+    const G4MaterialCutsCouple* couple = table->GetMaterialCutsCouple(i);
+    if (couple->GetMaterial() == material) {
+      return (*table->GetEnergyCutsVector(idxG4ElectronCut))[couple->GetIndex()];
+    }
+  }
+  return 0.;
+}
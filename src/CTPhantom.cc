@@ -0,0 +1,216 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/CTPhantom.cc
+/// \brief Implementation of the CTPhantom class
+//
+
+#include "CTPhantom.hh"
+#include "CTPhantomMessenger.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4PVParameterised.hh"
+#include "G4PhantomParameterisation.hh"
+#include "G4Material.hh"
+#include "G4NistManager.hh"
+#include "G4VisAttributes.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+CTPhantom::CTPhantom()
+:fMessenger(nullptr),fActive(false),fRegular(true),
+ fVoxelFile("phantom.dat"),fHUTableFile("hu2mat.dat"),fDensityStep(0.01*g/cm3),
+ fNx(0),fNy(0),fNz(0),fDx(0.),fDy(0.),fDz(0.)
+{
+  fMessenger = new CTPhantomMessenger(this);
+}
+
+CTPhantom::~CTPhantom()
+{
+  delete fMessenger;
+}
+
+G4bool CTPhantom::ReadHUTable()
+{
+  std::ifstream ifs(fHUTableFile);
+  if (!ifs.is_open()) {
+    G4cout << "\n--> warning from CTPhantom::ReadHUTable : cannot open "
+           << fHUTableFile << G4endl;
+    return false;
+  }
+
+  fHUMax.clear();
+  fHUMaterial.clear();
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    std::istringstream iss(line);
+    G4int huMax;
+    std::string name;
+    if (!(iss >> huMax >> name)) continue;
+    G4Material* material = G4NistManager::Instance()->FindOrBuildMaterial(name);
+    if (!material) {
+      G4cout << "\n--> warning from CTPhantom::ReadHUTable : "
+             << name << " not found" << G4endl;
+      return false;
+    }
+    fHUMax.push_back(huMax);
+    fHUMaterial.push_back(material);
+  }
+  return !fHUMax.empty();
+}
+
+G4Material* CTPhantom::VoxelMaterial(G4int hu)
+{
+  std::size_t range = 0;
+  while (range+1 < fHUMax.size() && hu > fHUMax[range]) ++range;
+
+  G4double density = std::max((hu + 1000.)/1000., 0.)*g/cm3;
+  G4int densityBin = std::max((G4int)std::lround(density/fDensityStep), 1);
+
+  std::pair<std::size_t,G4int> key(range, densityBin);
+  std::map<std::pair<std::size_t,G4int>, std::size_t>::iterator it =
+    fMaterialIndex.find(key);
+  if (it != fMaterialIndex.end()) {
+    fVoxelMaterial.push_back(it->second);
+    return fMaterials[it->second];
+  }
+
+  G4Material* base = fHUMaterial[range];
+  std::ostringstream name;
+  name << base->GetName() << "_" << densityBin*fDensityStep/(mg/cm3) << "mg";
+  G4Material* material = G4NistManager::Instance()->BuildMaterialWithNewDensity(
+                                 name.str(), base->GetName(),
+                                 densityBin*fDensityStep);
+  fMaterialIndex[key] = fMaterials.size();
+  fVoxelMaterial.push_back(fMaterials.size());
+  fMaterials.push_back(material);
+  return material;
+}
+
+G4bool CTPhantom::ReadVoxels()
+{
+  std::ifstream ifs(fVoxelFile);
+  if (!ifs.is_open()) {
+    G4cout << "\n--> warning from CTPhantom::ReadVoxels : cannot open "
+           << fVoxelFile << G4endl;
+    return false;
+  }
+
+  ifs >> fNx >> fNy >> fNz >> fDx >> fDy >> fDz;
+  if (!ifs || fNx <= 0 || fNy <= 0 || fNz <= 0) {
+    G4cout << "\n--> warning from CTPhantom::ReadVoxels : bad header in "
+           << fVoxelFile << G4endl;
+    return false;
+  }
+  fDx *= mm; fDy *= mm; fDz *= mm;
+
+  std::size_t nVoxels = (std::size_t)fNx*fNy*fNz;
+  fVoxelMaterial.clear();
+  fVoxelMaterial.reserve(nVoxels);
+  G4int hu;
+  for (std::size_t i = 0; i < nVoxels; ++i) {
+    if (!(ifs >> hu)) {
+      G4cout << "\n--> warning from CTPhantom::ReadVoxels : " << fVoxelFile
+             << " ends after " << i << " of " << nVoxels << " voxels" << G4endl;
+      return false;
+    }
+    VoxelMaterial(hu);
+  }
+
+  G4cout << " CT phantom " << fVoxelFile << ": " << fNx << "x" << fNy << "x"
+         << fNz << " voxels of " << fDx/mm << "x" << fDy/mm << "x" << fDz/mm
+         << " mm3, " << fMaterials.size() << " materials" << G4endl;
+  return true;
+}
+
+G4VPhysicalVolume* CTPhantom::Construct(G4LogicalVolume* mother)
+{
+  if (!ReadHUTable() || !ReadVoxels()) {
+    G4Exception("CTPhantom::Construct()", "MyCode0002", FatalException,
+                "cannot build the CT phantom, check the voxel and HU files");
+    return nullptr;
+  }
+
+  // container exactly filled by the voxels, centred on the beam axis
+  G4Box* containerSolid = new G4Box("Phantom",
+                                    fNx*fDx/2., fNy*fDy/2., fNz*fDz/2.);
+  G4LogicalVolume* containerLV =
+    new G4LogicalVolume(containerSolid, fMaterials[0], "Phantom");
+  G4VPhysicalVolume* containerPV =
+    new G4PVPlacement(nullptr, G4ThreeVector(), containerLV, "Phantom",
+                      mother, false, 0);
+
+  G4Box* voxelSolid = new G4Box("Voxel", fDx/2., fDy/2., fDz/2.);
+  G4int nVoxels = fNx*fNy*fNz;
+
+  if (fRegular) {
+    G4PhantomParameterisation* param = new G4PhantomParameterisation();
+    param->SetVoxelDimensions(fDx/2., fDy/2., fDz/2.);
+    param->SetNoVoxels(fNx, fNy, fNz);
+    param->SetMaterials(fMaterials);
+    // the parameterisation keeps the pointer: fVoxelMaterial lives as long
+    // as this object
+    param->SetMaterialIndices(fVoxelMaterial.data());
+    param->BuildContainerSolid(containerPV);
+    param->CheckVoxelsFillContainer(containerSolid->GetXHalfLength(),
+                                    containerSolid->GetYHalfLength(),
+                                    containerSolid->GetZHalfLength());
+
+    G4LogicalVolume* voxelLV =
+      new G4LogicalVolume(voxelSolid, fMaterials[0], "Voxel");
+    G4PVParameterised* voxelPV =
+      new G4PVParameterised("Voxel", voxelLV, containerLV, kUndefined,
+                            nVoxels, param);
+    voxelPV->SetRegularStructureId(1);
+  } else {
+    // naive reference: one placement per voxel, copy number = voxel index
+    std::vector<G4LogicalVolume*> voxelLV(fMaterials.size());
+    for (std::size_t m = 0; m < fMaterials.size(); ++m)
+      voxelLV[m] = new G4LogicalVolume(voxelSolid, fMaterials[m], "Voxel");
+
+    G4int copy = 0;
+    for (G4int iz = 0; iz < fNz; ++iz) {
+      for (G4int iy = 0; iy < fNy; ++iy) {
+        for (G4int ix = 0; ix < fNx; ++ix, ++copy) {
+          G4ThreeVector position((ix+0.5)*fDx - fNx*fDx/2.,
+                                 (iy+0.5)*fDy - fNy*fDy/2.,
+                                 (iz+0.5)*fDz - fNz*fDz/2.);
+          new G4PVPlacement(nullptr, position, voxelLV[fVoxelMaterial[copy]],
+                            "Voxel", containerLV, false, copy);
+        }
+      }
+    }
+  }
+
+  containerLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+  return containerPV;
+}
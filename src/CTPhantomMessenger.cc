@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/CTPhantomMessenger.cc
+/// \brief Implementation of the CTPhantomMessenger class
+//
+
+#include "CTPhantomMessenger.hh"
+
+#include "CTPhantom.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+CTPhantomMessenger::CTPhantomMessenger(CTPhantom* phantom)
+:G4UImessenger(),fPhantom(phantom),fPhantomDir(nullptr),fActiveCmd(nullptr),
+ fVoxelCmd(nullptr),fHUCmd(nullptr),fNavCmd(nullptr),fDensityStepCmd(nullptr)
+{ 
+  fPhantomDir = new G4UIdirectory("/testem/phantom/");
+  fPhantomDir->SetGuidance("voxelised CT phantom commands");
+
+  fActiveCmd = new G4UIcmdWithABool("/testem/phantom/activate",this);
+  fActiveCmd->SetGuidance("Replace the slab by the CT phantom.");
+  fActiveCmd->SetParameterName("flag",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit);
+  fActiveCmd->SetToBeBroadcasted(false);
+
+  fVoxelCmd = new G4UIcmdWithAString("/testem/phantom/voxelFile",this);
+  fVoxelCmd->SetGuidance("Voxel file: 'nx ny nz dx dy dz' (mm) then the HU values.");
+  fVoxelCmd->SetParameterName("file",false);
+  fVoxelCmd->AvailableForStates(G4State_PreInit);
+  fVoxelCmd->SetToBeBroadcasted(false);
+
+  fHUCmd = new G4UIcmdWithAString("/testem/phantom/huTable",this);
+  fHUCmd->SetGuidance("HU to material table: one 'HUmax material' per line.");
+  fHUCmd->SetParameterName("file",false);
+  fHUCmd->AvailableForStates(G4State_PreInit);
+  fHUCmd->SetToBeBroadcasted(false);
+
+  fNavCmd = new G4UIcmdWithAString("/testem/phantom/navigation",this);
+  fNavCmd->SetGuidance("regular: G4PhantomParameterisation + regular navigation");
+  fNavCmd->SetGuidance("nested : one placement per voxel (benchmark only)");
+  fNavCmd->SetParameterName("mode",false);
+  fNavCmd->SetCandidates("regular nested");
+  fNavCmd->AvailableForStates(G4State_PreInit);
+  fNavCmd->SetToBeBroadcasted(false);
+
+  fDensityStepCmd = new G4UIcmdWithADoubleAndUnit("/testem/phantom/setDensityStep",this);
+  fDensityStepCmd->SetGuidance("Voxel densities are rounded to this step.");
+  fDensityStepCmd->SetParameterName("step",false);
+  fDensityStepCmd->SetRange("step>0.");
+  fDensityStepCmd->SetUnitCategory("Volumic Mass");
+  fDensityStepCmd->AvailableForStates(G4State_PreInit);
+  fDensityStepCmd->SetToBeBroadcasted(false);
+}
+
+CTPhantomMessenger::~CTPhantomMessenger()
+{
+  delete fActiveCmd;
+  delete fVoxelCmd;
+  delete fHUCmd;
+  delete fNavCmd;
+  delete fDensityStepCmd;
+  delete fPhantomDir;
+}
+
+void CTPhantomMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fActiveCmd )
+   { fPhantom->SetActive(fActiveCmd->GetNewBoolValue(newValue));}
+
+  if( command == fVoxelCmd )
+   { fPhantom->SetVoxelFile(newValue);}
+
+  if( command == fHUCmd )
+   { fPhantom->SetHUTableFile(newValue);}
+
+  if( command == fNavCmd )
+   { fPhantom->SetRegularNavigation(newValue == "regular");}
+
+  if( command == fDensityStepCmd )
+   { fPhantom->SetDensityStep(fDensityStepCmd->GetNewDoubleValue(newValue));}
+}
@@ -0,0 +1,182 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/Checkpoint.cc
+/// \brief Implementation of the Checkpoint class
+//
+
+#include "Checkpoint.hh"
+#include "CheckpointMessenger.hh"
+#include "RunAction.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+Checkpoint::Checkpoint(RunAction* run)
+:fRunAction(run),fMessenger(nullptr),fEveryEvents(0),fEverySeconds(0.),
+ fFileName("checkpoint.dat"),fRunID(0),fEventsRequested(0),fEventsDone(0),
+ fRestoredEvents(0),fSkipping(false),fResumePending(false),fResumeRunID(-1),
+ fResumeEvents(0)
+{
+  fMessenger = new CheckpointMessenger(this);
+}
+
+Checkpoint::~Checkpoint()
+{
+  delete fMessenger;
+}
+
+void Checkpoint::SetResume(G4bool val)
+{
+  fResumePending = val;
+  fResumeRunID = -1;
+  if (val) WriteOutputFile::GetInstance()->SetAppend();
+}
+
+G4bool Checkpoint::ReadHeader()
+{
+  std::ifstream in(fFileName);
+  in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  G4int requested = 0;
+  in >> fResumeRunID >> requested >> fResumeEvents;
+  if (!in) {
+    fResumeRunID = -1;
+    return false;
+  }
+  return true;
+}
+
+G4int Checkpoint::BeginOfRun(const G4Run* run)
+{
+  fRunID = run->GetRunID();
+  fEventsRequested = run->GetNumberOfEventToBeProcessed();
+  fEventsDone = 0;
+  fRestoredEvents = 0;
+  fSkipping = false;
+  fLastWrite = std::chrono::steady_clock::now();
+
+  // one tally set and one engine per thread: not supported yet
+  if (G4Threading::IsMultithreadedApplication() &&
+      (fEveryEvents > 0 || fEverySeconds > 0. || fResumePending)) {
+    if (G4Threading::IsMasterThread())
+      G4cout << "\n--> warning from Checkpoint::BeginOfRun : checkpoints "
+             << "need the sequential run manager, switched off" << G4endl;
+    fEveryEvents = 0;
+    fEverySeconds = 0.;
+    fResumePending = false;
+  }
+
+  if (!fResumePending) return 0;
+
+  if (fResumeRunID < 0 && !ReadHeader()) {
+    G4cout << "\n--> warning from Checkpoint::BeginOfRun : no checkpoint in "
+           << fFileName << ", starting from scratch" << G4endl;
+    fResumePending = false;
+    return 0;
+  }
+
+  // runs finished before the checkpoint already have their results
+  if (fRunID < fResumeRunID ||
+      (fRunID == fResumeRunID && fResumeEvents >= fEventsRequested)) {
+    fSkipping = true;
+    if (fRunID == fResumeRunID) fResumePending = false;
+    G4cout << "run " << fRunID << " completed before the checkpoint, skipped"
+           << G4endl;
+    return 0;
+  }
+  fResumePending = false;
+  if (fRunID != fResumeRunID) return 0;
+
+  std::ifstream in(fFileName);
+  in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  G4int runID, requested, done;
+  in >> runID >> requested >> done;
+  if (!fRunAction->ReadTallies(in, done) ||
+      !G4Random::getTheEngine()->get(in)) {
+    G4cout << "\n--> warning from Checkpoint::BeginOfRun : " << fFileName
+           << " does not match this run, starting from scratch" << G4endl;
+    return 0;
+  }
+  fEventsDone = fRestoredEvents = done;
+  G4cout << "run " << fRunID << " resumed from " << fFileName << " after "
+         << done << " of " << fEventsRequested << " events" << G4endl;
+  return done;
+}
+
+void Checkpoint::EndOfEvent()
+{
+  ++fEventsDone;
+
+  // a skipped run stops at once, a resumed one at the requested total
+  if (fSkipping ||
+      (fRestoredEvents > 0 && fEventsDone >= fEventsRequested)) {
+    G4RunManager::GetRunManager()->AbortRun(true);
+    return;
+  }
+
+  G4bool due = (fEveryEvents > 0 && fEventsDone % fEveryEvents == 0);
+  if (!due && fEverySeconds > 0.) {
+    std::chrono::duration<G4double> elapsed =
+      std::chrono::steady_clock::now() - fLastWrite;
+    due = (elapsed.count() >= fEverySeconds);
+  }
+  if (due) Write();
+}
+
+void Checkpoint::EndOfRun()
+{
+  if (fSkipping || (fEveryEvents <= 0 && fEverySeconds <= 0.)) return;
+
+  // the results of the run are on disk before it is marked complete
+  WriteOutputFile::GetInstance()->Flush();
+  Write();
+}
+
+void Checkpoint::Write()
+{
+  G4String tmpName = fFileName + ".tmp";
+  {
+    std::ofstream out(tmpName);
+    out << std::setprecision(17);
+    out << "# run events-requested events-done, tallies, engine" << '\n';
+    out << fRunID << ' ' << fEventsRequested << ' ' << fEventsDone << '\n';
+    fRunAction->WriteTallies(out);
+    G4Random::getTheEngine()->put(out);
+    if (!out) {
+      G4cout << "\n--> warning from Checkpoint::Write : cannot write "
+             << tmpName << G4endl;
+      return;
+    }
+  }
+  std::rename(tmpName.c_str(), fFileName.c_str());
+  fLastWrite = std::chrono::steady_clock::now();
+}
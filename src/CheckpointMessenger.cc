@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/CheckpointMessenger.cc
+/// \brief Implementation of the CheckpointMessenger class
+//
+
+#include "CheckpointMessenger.hh"
+
+#include "Checkpoint.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4SystemOfUnits.hh"
+
+CheckpointMessenger::CheckpointMessenger(Checkpoint* checkpoint)
+:G4UImessenger(),fCheckpoint(checkpoint),fCheckDir(nullptr),fEventsCmd(nullptr),
+ fTimeCmd(nullptr),fFileCmd(nullptr),fResumeCmd(nullptr)
+{ 
+  fCheckDir = new G4UIdirectory("/testem/checkpoint/");
+  fCheckDir->SetGuidance("checkpoint and resume of long runs");
+
+  fEventsCmd = new G4UIcmdWithAnInteger("/testem/checkpoint/everyEvents",this);
+  fEventsCmd->SetGuidance("Write a checkpoint every N events (0 = never).");
+  fEventsCmd->SetParameterName("N",false);
+  fEventsCmd->SetRange("N>=0");
+  fEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fTimeCmd = new G4UIcmdWithADoubleAndUnit("/testem/checkpoint/everyTime",this);
+  fTimeCmd->SetGuidance("Write a checkpoint every T of wall time (0 = never).");
+  fTimeCmd->SetParameterName("T",false);
+  fTimeCmd->SetRange("T>=0.");
+  fTimeCmd->SetUnitCategory("Time");
+  fTimeCmd->SetDefaultUnit("s");
+  fTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/checkpoint/setFileName",this);
+  fFileCmd->SetGuidance("Set name of the checkpoint file.");
+  fFileCmd->SetParameterName("file",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fResumeCmd = new G4UIcmdWithABool("/testem/checkpoint/resume",this);
+  fResumeCmd->SetGuidance("Continue from the checkpoint file (same as --resume).");
+  fResumeCmd->SetParameterName("resume",true);
+  fResumeCmd->SetDefaultValue(true);
+  fResumeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+CheckpointMessenger::~CheckpointMessenger()
+{
+  delete fEventsCmd;
+  delete fTimeCmd;
+  delete fFileCmd;
+  delete fResumeCmd;
+  delete fCheckDir;
+}
+
+void CheckpointMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fEventsCmd )
+   { fCheckpoint->SetEveryEvents(fEventsCmd->GetNewIntValue(newValue));}
+
+  if( command == fTimeCmd )
+   { fCheckpoint->SetEverySeconds(fTimeCmd->GetNewDoubleValue(newValue)/s);}
+
+  if( command == fFileCmd )
+   { fCheckpoint->SetFileName(newValue);}
+
+  if( command == fResumeCmd )
+   { fCheckpoint->SetResume(fResumeCmd->GetNewBoolValue(newValue));}
+}
@@ -28,14 +28,20 @@
 //
 #include "DetectorConstruction.hh"
 #include "DetectorMessenger.hh"
+#include "AttenuationCalculator.hh"
+#include "SlabFastSimModel.hh"
+#include "CTPhantom.hh"
 
 #include "G4Material.hh"
 #include "G4NistManager.hh"
 #include "G4Box.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4Region.hh"
+#include "G4ParticleDefinition.hh"
 
 #include "G4GeometryManager.hh"
+#include "G4StateManager.hh"
 #include "G4PhysicalVolumeStore.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4SolidStore.hh"
@@ -47,24 +53,41 @@
 #include "G4Colour.hh"
 #include "G4VisAttributes.hh"
 
+#include <algorithm>
+
 DetectorConstruction::DetectorConstruction()
 :G4VUserDetectorConstruction(),
- fworld(nullptr), sBox(nullptr), lBox(nullptr), fBox(nullptr),fMaterial(nullptr),fDetectorMessenger(nullptr), fVacuum(nullptr), fWater(nullptr)
+ fworld(nullptr), sBox(nullptr), lBox(nullptr), fBox(nullptr),fMaterial(nullptr),fDetectorMessenger(nullptr), fVacuum(nullptr), fWater(nullptr),
+ fAutoThickness(false), fTargetMuX(2.), fCalculator(nullptr),
+ fSlabRegion(nullptr), fFastSimulation(false), fPhantom(nullptr),
+ fLaneWidth(10.*cm)
 {
   // The thickness of the slab along the X direction is 1. mm by default
   DefineMaterials();
   fMaterial= fWater;
   fDetectorMessenger = new DetectorMessenger(this);
+  fPhantom = new CTPhantom();
 }
 
 DetectorConstruction::~DetectorConstruction()
-{ delete fDetectorMessenger;}
+{ delete fPhantom;
+  delete fCalculator;
+  delete fDetectorMessenger;}
+
+G4ThreadLocal SlabFastSimModel* DetectorConstruction::fFastSimModel = nullptr;
 
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
   return ConstructVolumes();
 }
 
+void DetectorConstruction::ConstructSDandField()
+{
+  // no model, and no trigger on every gamma step, unless it is wanted
+  if (!fFastSimModel && fSlabRegion && GetFastSimulation())
+    fFastSimModel = new SlabFastSimModel("SlabFastSim", fSlabRegion, this);
+}
+
 void DetectorConstruction::DefineMaterials()
 {
   G4NistManager* manager = G4NistManager::Instance();
@@ -117,23 +140,54 @@ G4VPhysicalVolume* DetectorConstruction::ConstructVolumes()
   // The world is invisible
   lworld -> SetVisAttributes (G4VisAttributes::GetInvisible());
 
-  // slab 
-  sBox = new G4Box("Target",                //its name
-                     1.*mm,10000.*m,10000.*m);        //its dimensions // 20 km
+  std::vector<G4LogicalVolume*> laneLogicals;
+  if (fPhantom->IsActive()) {
+    // CT volume: the phantom container takes the place of the slab
+    fBox = fPhantom->Construct(lworld);
+    lBox = fBox->GetLogicalVolume();
+    sBox = static_cast<G4Box*>(lBox->GetSolid());
+    fMaterial = lBox->GetMaterial();
+  } else if (!fLaneMaterials.empty()) {
+    // lanes share one solid, so that SetThickness resizes all of them
+    G4int nLanes = fLaneMaterials.size();
+    sBox = new G4Box("Target", 1.*mm, 0.5*fLaneWidth, 10000.*m);
+    for (G4int lane = 0; lane < nLanes; ++lane) {
+      G4Material* material = fLaneMaterials[lane];
+      G4LogicalVolume* logical =
+        new G4LogicalVolume(sBox, material, material->GetName());
+      G4double y = (lane + 0.5 - 0.5*nLanes)*fLaneWidth;
+      G4VPhysicalVolume* physical =
+        new G4PVPlacement(nullptr, G4ThreeVector(0.,y,0.), logical,
+                          material->GetName(), lworld, false, lane);
+      laneLogicals.push_back(logical);
+      // the first lane stands for the slab in the single-slab interfaces
+      if (lane == 0) {lBox = logical; fBox = physical;}
+    }
+    fMaterial = lBox->GetMaterial();
+  } else {
+    // slab 
+    sBox = new G4Box("Target",                //its name
+                       1.*mm,10000.*m,10000.*m);        //its dimensions // 20 km
                    
   
-  lBox = new G4LogicalVolume(sBox,                        //its shape
-                               fMaterial,                //its material
-                               fMaterial->GetName());        //its name
-
-  fBox = new G4PVPlacement(nullptr,                                //no rotation
-                           G4ThreeVector(),                //at (0,0,0)
-                           lBox,                        //its logical volume
-                           fMaterial->GetName(),        //its name
-                           lworld,                                //its mother  volume
-                           false,                        //no boolean operation
-                           0);                                //copy number
+    lBox = new G4LogicalVolume(sBox,                        //its shape
+                                 fMaterial,                //its material
+                                 fMaterial->GetName());        //its name
+
+    fBox = new G4PVPlacement(nullptr,                                //no rotation
+                             G4ThreeVector(),                //at (0,0,0)
+                             lBox,                        //its logical volume
+                             fMaterial->GetName(),        //its name
+                             lworld,                                //its mother  volume
+                             false,                        //no boolean operation
+                             0);                                //copy number
+  }
     
+  // the slab is the envelope of the fast simulation model
+  fSlabRegion = new G4Region("Target");
+  fSlabRegion->AddRootLogicalVolume(lBox);
+  for (G4LogicalVolume* logical : laneLogicals)
+    if (logical != lBox) fSlabRegion->AddRootLogicalVolume(logical);
 
  // Visualisation attributes
  // Visualization attributes of the phantom 
@@ -178,8 +232,21 @@ void DetectorConstruction::SetMaterial(G4String materialChoice)
 
 void DetectorConstruction::SetThickness(G4double thickness)
 {
+if (fPhantom->IsActive()) {
+  G4cout << "\n--> warning from DetectorConstruction::SetThickness : "
+         << "the CT phantom has a fixed size" << G4endl;
+  return;
+}
+
+// inside a run (auto-thickness) the navigator has to see the new slab
+G4bool closed =
+  (G4StateManager::GetStateManager()->GetCurrentState() == G4State_GeomClosed);
+if (closed) G4GeometryManager::GetInstance()->OpenGeometry(fworld);
+
 if (sBox) sBox-> SetXHalfLength(thickness/2.);
 
+if (closed) G4GeometryManager::GetInstance()->CloseGeometry(true, false, fworld);
+
 if (sBox) G4cout << " The Target thickness is (mm): " << ((sBox -> GetXHalfLength())*2.)/mm << G4endl; 
 
 PrintParameters();
@@ -187,6 +254,60 @@ PrintParameters();
   //  G4RunManager::GetRunManager() -> PhysicsHasBeenModified();
 }
 
+void DetectorConstruction::OptimizeThickness(const G4ParticleDefinition* particle,
+                                             G4double energy)
+{
+  if (!sBox || !particle) return;
+  // the lanes share one solid: no thickness fits every material
+  if (!fLaneMaterials.empty()) {
+    G4cout << "\n--> warning from DetectorConstruction::OptimizeThickness : "
+           << "no auto-thickness with lanes, thickness unchanged" << G4endl;
+    return;
+  }
+  if (!fCalculator) fCalculator = new AttenuationCalculator();
+
+  // analytic pilot: total macroscopic cross section of the active physics
+  G4double sigma = fCalculator->ComputeCrossSectionPerVolume(particle, energy,
+                                                     lBox->GetMaterial());
+  if (sigma <= 0.) {
+    G4cout << "\n--> warning from DetectorConstruction::OptimizeThickness : "
+           << "no cross section for " << particle->GetParticleName()
+           << " in " << lBox->GetMaterial()->GetName()
+           << ", thickness unchanged" << G4endl;
+    return;
+  }
+
+  // keep the slab inside the world
+  G4double thickness = std::min(fTargetMuX/sigma, 2.*sBox->GetYHalfLength());
+  G4cout << " Auto-thickness: mu*x = " << fTargetMuX << " at "
+         << G4BestUnit(energy,"Energy") << G4endl;
+  SetThickness(thickness);
+}
+
+G4bool DetectorConstruction::GetFastSimulation()
+{
+  // a single cross section only makes sense for the homogeneous slab
+  return fFastSimulation && !fPhantom->IsActive() && fLaneMaterials.empty();
+}
+
+void DetectorConstruction::AddLane(const G4String& materialName)
+{
+  G4Material* material =
+     G4NistManager::Instance()->FindOrBuildMaterial(materialName);
+  if (!material) {
+    G4cout << "\n--> warning from DetectorConstruction::AddLane : "
+           << materialName << " not found" << G4endl;
+    return;
+  }
+  if (fPhantom->IsActive()) {
+    G4cout << "\n--> warning from DetectorConstruction::AddLane : "
+           << "the CT phantom replaces the lanes, " << materialName
+           << " not added" << G4endl;
+    return;
+  }
+  fLaneMaterials.push_back(material);
+}
+
 G4double DetectorConstruction::GetDensity()
 {
 
@@ -35,11 +35,14 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithABool.hh"
 
 
 DetectorMessenger::DetectorMessenger(DetectorConstruction * Det)
 :G4UImessenger(),fDetector(Det),fTestemDir(nullptr),fDetDir(nullptr),
-fMaterCmd(nullptr),fThickCmd(nullptr)
+fMaterCmd(nullptr),fThickCmd(nullptr),fAutoThickCmd(nullptr),fMuXCmd(nullptr),
+fFastSimCmd(nullptr),fAddLaneCmd(nullptr),fLaneWidthCmd(nullptr)
 { 
   fTestemDir = new G4UIdirectory("/testem/");
   fTestemDir->SetGuidance("commands specific to this example");
@@ -50,7 +53,8 @@ fMaterCmd(nullptr),fThickCmd(nullptr)
   fMaterCmd = new G4UIcmdWithAString("/testem/det/setMat",this);
   fMaterCmd->SetGuidance("Select material of the box.");
   fMaterCmd->SetParameterName("choice",false);
-  fMaterCmd->AvailableForStates(G4State_PreInit,G4State_Idle); 
+  fMaterCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaterCmd->SetToBeBroadcasted(false);
 
   fThickCmd = new G4UIcmdWithADoubleAndUnit("/testem/det/setThickness",this);
   fThickCmd->SetGuidance("Select Thickness of the slab along X direction.");
@@ -58,11 +62,56 @@ fMaterCmd(nullptr),fThickCmd(nullptr)
   fThickCmd->SetRange("Size>=0.");
   fThickCmd->SetUnitCategory("Length");
   fThickCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fThickCmd->SetToBeBroadcasted(false);
+
+  fAutoThickCmd = new G4UIcmdWithABool("/testem/det/autoThickness",this);
+  fAutoThickCmd->SetGuidance("Resize the slab before each run so that mu*x");
+  fAutoThickCmd->SetGuidance("matches the target (see setTargetMuX).");
+  fAutoThickCmd->SetParameterName("auto",true);
+  fAutoThickCmd->SetDefaultValue(true);
+  fAutoThickCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAutoThickCmd->SetToBeBroadcasted(false);
+
+  fMuXCmd = new G4UIcmdWithADouble("/testem/det/setTargetMuX",this);
+  fMuXCmd->SetGuidance("Set the mu*x aimed at by the auto-thickness mode.");
+  fMuXCmd->SetParameterName("muX",false);
+  fMuXCmd->SetRange("muX>0.");
+  fMuXCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMuXCmd->SetToBeBroadcasted(false);
+
+  fFastSimCmd = new G4UIcmdWithABool("/testem/det/fastSimulation",this);
+  fFastSimCmd->SetGuidance("Sample the first interaction of primary gammas");
+  fFastSimCmd->SetGuidance("in the slab instead of tracking them; collided");
+  fFastSimCmd->SetGuidance("primaries are absorbed (narrow beam only).");
+  fFastSimCmd->SetParameterName("fast",true);
+  fFastSimCmd->SetDefaultValue(true);
+  fFastSimCmd->AvailableForStates(G4State_PreInit);
+  fFastSimCmd->SetToBeBroadcasted(false);
+
+  fAddLaneCmd = new G4UIcmdWithAString("/testem/det/addLane",this);
+  fAddLaneCmd->SetGuidance("Add a lane of this material next to the others");
+  fAddLaneCmd->SetGuidance("along y; the lanes replace the slab.");
+  fAddLaneCmd->SetParameterName("material",false);
+  fAddLaneCmd->AvailableForStates(G4State_PreInit);
+  fAddLaneCmd->SetToBeBroadcasted(false);
+
+  fLaneWidthCmd = new G4UIcmdWithADoubleAndUnit("/testem/det/setLaneWidth",this);
+  fLaneWidthCmd->SetGuidance("Set width of a lane along y.");
+  fLaneWidthCmd->SetParameterName("width",false);
+  fLaneWidthCmd->SetRange("width>0.");
+  fLaneWidthCmd->SetUnitCategory("Length");
+  fLaneWidthCmd->AvailableForStates(G4State_PreInit);
+  fLaneWidthCmd->SetToBeBroadcasted(false);
 }
 
 DetectorMessenger::~DetectorMessenger()
 {
   delete fThickCmd;
+  delete fAutoThickCmd;
+  delete fMuXCmd;
+  delete fFastSimCmd;
+  delete fAddLaneCmd;
+  delete fLaneWidthCmd;
   delete fMaterCmd;
   delete fDetDir;
   delete fTestemDir;
@@ -75,5 +124,20 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
 
   if(command == fThickCmd)
    { fDetector -> SetThickness(fThickCmd->GetNewDoubleValue(newValue));}
+
+  if(command == fAutoThickCmd)
+   { fDetector -> SetAutoThickness(fAutoThickCmd->GetNewBoolValue(newValue));}
+
+  if(command == fMuXCmd)
+   { fDetector -> SetTargetMuX(fMuXCmd->GetNewDoubleValue(newValue));}
+
+  if(command == fFastSimCmd)
+   { fDetector -> SetFastSimulation(fFastSimCmd->GetNewBoolValue(newValue));}
+
+  if(command == fAddLaneCmd)
+   { fDetector -> AddLane(newValue);}
+
+  if(command == fLaneWidthCmd)
+   { fDetector -> SetLaneWidth(fLaneWidthCmd->GetNewDoubleValue(newValue));}
 }
 
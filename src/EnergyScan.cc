@@ -0,0 +1,183 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/EnergyScan.cc
+/// \brief Implementation of the EnergyScan class
+//
+
+#include "EnergyScan.hh"
+#include "EnergyScanMessenger.hh"
+#include "AttenuationCalculator.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4Material.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <queue>
+#include <algorithm>
+
+namespace {
+
+// an interval of the grid with the analytic mu at its ends and at its
+// geometric centre; error is the log-log interpolation error at the centre
+struct Interval
+{
+  G4double e1, e2, em;
+  G4double mu1, mu2, mum;
+  G4double error;
+  bool operator<(const Interval& other) const {return error < other.error;}
+};
+
+}
+
+EnergyScan::EnergyScan(DetectorConstruction* det, PrimaryGeneratorAction* prim)
+:fDetector(det),fPrimary(prim),fMessenger(nullptr),fCalculator(nullptr),
+ fEnergyMin(10*keV),fEnergyMax(10*MeV),fTolerance(0.01),fMinRelWidth(1.e-4),
+ fMaxPoints(50),fInitialPoints(5),fEventsPerPoint(100000)
+{
+  fMessenger = new EnergyScanMessenger(this);
+  fCalculator = new AttenuationCalculator();
+}
+
+EnergyScan::~EnergyScan()
+{
+  delete fCalculator;
+  delete fMessenger;
+}
+
+G4double EnergyScan::ComputeMu(G4double energy)
+{
+  return fCalculator->ComputeMassAttenuation(
+                     fPrimary->GetParticleGun()->GetParticleDefinition(),
+                     energy, fDetector->GetMaterial());
+}
+
+void EnergyScan::BuildGrid()
+{
+  fEnergies.clear();
+  fMu.clear();
+  fError.clear();
+
+  if (fEnergyMin <= 0. || fEnergyMax <= fEnergyMin || fInitialPoints < 2) {
+    G4cout << "\n--> warning from EnergyScan::BuildGrid : invalid range "
+           << G4BestUnit(fEnergyMin,"Energy") << " - "
+           << G4BestUnit(fEnergyMax,"Energy") << G4endl;
+    return;
+  }
+
+  // the cross sections need the physics tables
+  G4RunManager::GetRunManager()->BeamOn(0);
+
+  auto makeInterval = [this](G4double e1, G4double mu1,
+                             G4double e2, G4double mu2) {
+    Interval interval;
+    interval.e1 = e1; interval.mu1 = mu1;
+    interval.e2 = e2; interval.mu2 = mu2;
+    interval.em = std::sqrt(e1*e2);
+    interval.mum = ComputeMu(interval.em);
+    interval.error = 0.;
+    if (mu1 > 0. && mu2 > 0. && interval.mum > 0.) {
+      // log-log midpoint is the geometric mean of the end values
+      G4double predicted = std::sqrt(mu1*mu2);
+      interval.error = std::abs(predicted/interval.mum - 1.);
+    }
+    if (e2/e1 - 1. < fMinRelWidth) interval.error = 0.;
+    return interval;
+  };
+
+  // coarse logarithmic grid
+  std::vector<G4double> energies(fInitialPoints), mu(fInitialPoints);
+  G4double ratio = std::log(fEnergyMax/fEnergyMin)/(fInitialPoints-1);
+  for (G4int i = 0; i < fInitialPoints; ++i) {
+    energies[i] = fEnergyMin*std::exp(ratio*i);
+    mu[i] = ComputeMu(energies[i]);
+  }
+
+  std::priority_queue<Interval> queue;
+  for (G4int i = 0; i < fInitialPoints-1; ++i) {
+    queue.push(makeInterval(energies[i], mu[i], energies[i+1], mu[i+1]));
+  }
+
+  // split the worst interval until the tolerance or the budget is reached
+  G4int nPoints = fInitialPoints;
+  while (!queue.empty() && nPoints < fMaxPoints
+         && queue.top().error > fTolerance) {
+    Interval worst = queue.top();
+    queue.pop();
+    energies.push_back(worst.em);
+    mu.push_back(worst.mum);
+    ++nPoints;
+    queue.push(makeInterval(worst.e1, worst.mu1, worst.em, worst.mum));
+    queue.push(makeInterval(worst.em, worst.mum, worst.e2, worst.mu2));
+  }
+
+  // residual error estimate of every interval, assigned to its lower end
+  std::vector<std::pair<G4double,G4double> > residual;
+  while (!queue.empty()) {
+    residual.push_back(std::make_pair(queue.top().e1, queue.top().error));
+    queue.pop();
+  }
+  std::sort(residual.begin(), residual.end());
+
+  std::vector<std::size_t> order(energies.size());
+  for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&energies](std::size_t a, std::size_t b)
+            {return energies[a] < energies[b];});
+
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    fEnergies.push_back(energies[order[i]]);
+    fMu.push_back(mu[order[i]]);
+    G4double error = 0.;
+    if (i < residual.size()) error = residual[i].second;
+    fError.push_back(error);
+  }
+
+  G4cout << "\n EnergyScan: " << fEnergies.size() << " points between "
+         << G4BestUnit(fEnergyMin,"Energy") << " and "
+         << G4BestUnit(fEnergyMax,"Energy") << " in "
+         << fDetector->GetMaterial()->GetName() << G4endl;
+
+  WriteOutputFile* output = WriteOutputFile::GetInstance();
+  for (std::size_t i = 0; i < fEnergies.size(); ++i) {
+    output->FillEnergyGrid(fEnergies[i]/MeV, fMu[i]/(cm2/g), fError[i]);
+  }
+}
+
+void EnergyScan::Run()
+{
+  BuildGrid();
+
+  // the worker guns are not the master's: the energy goes by UI command
+  for (std::size_t i = 0; i < fEnergies.size(); ++i) {
+    fPrimary->SetEnergyOfAllGuns(fEnergies[i]);
+    G4RunManager::GetRunManager()->BeamOn(fEventsPerPoint);
+  }
+}
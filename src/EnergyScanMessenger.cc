@@ -0,0 +1,139 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/EnergyScanMessenger.cc
+/// \brief Implementation of the EnergyScanMessenger class
+//
+
+#include "EnergyScanMessenger.hh"
+
+#include "EnergyScan.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+EnergyScanMessenger::EnergyScanMessenger(EnergyScan* scan)
+:G4UImessenger(),fScan(scan),fScanDir(nullptr),fEminCmd(nullptr),
+ fEmaxCmd(nullptr),fTolCmd(nullptr),fMaxPointsCmd(nullptr),
+ fInitPointsCmd(nullptr),fEventsCmd(nullptr),fGridCmd(nullptr),fRunCmd(nullptr)
+{ 
+  fScanDir = new G4UIdirectory("/testem/scan/");
+  fScanDir->SetGuidance("adaptive energy scan commands");
+
+  fEminCmd = new G4UIcmdWithADoubleAndUnit("/testem/scan/setEmin",this);
+  fEminCmd->SetGuidance("Set lower end of the energy scan.");
+  fEminCmd->SetParameterName("Emin",false);
+  fEminCmd->SetRange("Emin>0.");
+  fEminCmd->SetUnitCategory("Energy");
+  fEminCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEminCmd->SetToBeBroadcasted(false);
+
+  fEmaxCmd = new G4UIcmdWithADoubleAndUnit("/testem/scan/setEmax",this);
+  fEmaxCmd->SetGuidance("Set upper end of the energy scan.");
+  fEmaxCmd->SetParameterName("Emax",false);
+  fEmaxCmd->SetRange("Emax>0.");
+  fEmaxCmd->SetUnitCategory("Energy");
+  fEmaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEmaxCmd->SetToBeBroadcasted(false);
+
+  fTolCmd = new G4UIcmdWithADouble("/testem/scan/setTolerance",this);
+  fTolCmd->SetGuidance("Set target relative log-log interpolation error on mu.");
+  fTolCmd->SetParameterName("tol",false);
+  fTolCmd->SetRange("tol>0.");
+  fTolCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fTolCmd->SetToBeBroadcasted(false);
+
+  fMaxPointsCmd = new G4UIcmdWithAnInteger("/testem/scan/setMaxPoints",this);
+  fMaxPointsCmd->SetGuidance("Set maximum number of energy points.");
+  fMaxPointsCmd->SetParameterName("nmax",false);
+  fMaxPointsCmd->SetRange("nmax>1");
+  fMaxPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaxPointsCmd->SetToBeBroadcasted(false);
+
+  fInitPointsCmd = new G4UIcmdWithAnInteger("/testem/scan/setInitialPoints",this);
+  fInitPointsCmd->SetGuidance("Set number of points of the starting log grid.");
+  fInitPointsCmd->SetParameterName("ninit",false);
+  fInitPointsCmd->SetRange("ninit>1");
+  fInitPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fInitPointsCmd->SetToBeBroadcasted(false);
+
+  fEventsCmd = new G4UIcmdWithAnInteger("/testem/scan/setEvents",this);
+  fEventsCmd->SetGuidance("Set number of events per energy point.");
+  fEventsCmd->SetParameterName("nevt",false);
+  fEventsCmd->SetRange("nevt>0");
+  fEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEventsCmd->SetToBeBroadcasted(false);
+
+  fGridCmd = new G4UIcmdWithoutParameter("/testem/scan/buildGrid",this);
+  fGridCmd->SetGuidance("Build and record the adaptive grid without running.");
+  fGridCmd->AvailableForStates(G4State_Idle);
+  fGridCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithoutParameter("/testem/scan/run",this);
+  fRunCmd->SetGuidance("Build the adaptive grid and do one run per point.");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+}
+
+EnergyScanMessenger::~EnergyScanMessenger()
+{
+  delete fEminCmd;
+  delete fEmaxCmd;
+  delete fTolCmd;
+  delete fMaxPointsCmd;
+  delete fInitPointsCmd;
+  delete fEventsCmd;
+  delete fGridCmd;
+  delete fRunCmd;
+  delete fScanDir;
+}
+
+void EnergyScanMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fEminCmd )
+   { fScan->SetEnergyMin(fEminCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEmaxCmd )
+   { fScan->SetEnergyMax(fEmaxCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fTolCmd )
+   { fScan->SetTolerance(fTolCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fMaxPointsCmd )
+   { fScan->SetMaxPoints(fMaxPointsCmd->GetNewIntValue(newValue));}
+
+  if( command == fInitPointsCmd )
+   { fScan->SetInitialPoints(fInitPointsCmd->GetNewIntValue(newValue));}
+
+  if( command == fEventsCmd )
+   { fScan->SetEventsPerPoint(fEventsCmd->GetNewIntValue(newValue));}
+
+  if( command == fGridCmd )
+   { fScan->BuildGrid();}
+
+  if( command == fRunCmd )
+   { fScan->Run();}
+}
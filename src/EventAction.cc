@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/EventAction.cc
+/// \brief Implementation of the EventAction class
+//
+
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "Checkpoint.hh"
+#include "ProgressMonitor.hh"
+#include "EventWatchdog.hh"
+#include "PerturbationEstimator.hh"
+#include "ExpectedValueEstimator.hh"
+
+#include "G4Event.hh"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+// seconds since the process was started (exec, library loading included),
+// from /proc; negative where it is not available
+G4double SecondsSinceProcessStart()
+{
+  std::ifstream stat("/proc/self/stat");
+  std::ifstream uptime("/proc/uptime");
+  std::string line;
+  G4double now = 0.;
+  if (!std::getline(stat, line) || !(uptime >> now)) return -1.;
+
+  // the command name may hold spaces: fields are counted after it
+  std::istringstream fields(line.substr(line.rfind(')') + 2));
+  std::string field;
+  for (G4int i = 3; i < 22; ++i) fields >> field;
+  unsigned long long startTicks = 0;
+  if (!(fields >> startTicks)) return -1.;
+  return now - G4double(startTicks)/sysconf(_SC_CLK_TCK);
+}
+
+std::atomic<G4bool> firstEventSeen(false);
+
+}
+
+EventAction::EventAction(RunAction* run)
+:G4UserEventAction(),fRunAction(run)
+{ }
+
+EventAction::~EventAction()
+{ }
+
+void EventAction::BeginOfEventAction(const G4Event*)
+{
+  fRunAction->GetWatchdog()->BeginOfEvent();
+  fRunAction->GetPerturbation()->BeginOfEvent();
+  fRunAction->GetExpectedValue()->BeginOfEvent();
+
+  // start-up cost of the job: once per process, by whichever thread is first
+  if (firstEventSeen.exchange(true, std::memory_order_relaxed)) return;
+  G4double startup = SecondsSinceProcessStart();
+  if (startup >= 0.)
+    G4cout << "start-up: " << startup << " s from process start to first event"
+           << G4endl;
+}
+
+void EventAction::EndOfEventAction(const G4Event* event)
+{
+  fRunAction->GetWatchdog()->EndOfEvent(event);
+  fRunAction->GetExpectedValue()->EndOfEvent();
+  fRunAction->GetProgressMonitor()->EndOfEvent();
+  fRunAction->GetCheckpoint()->EndOfEvent();
+}
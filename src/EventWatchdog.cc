@@ -0,0 +1,187 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/EventWatchdog.cc
+/// \brief Implementation of the EventWatchdog class
+//
+
+#include "EventWatchdog.hh"
+#include "WatchdogMessenger.hh"
+
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+  G4Mutex indexMutex = G4MUTEX_INITIALIZER;
+  // the index file is truncated by the first aborted event of the job
+  G4bool indexStarted = false;
+}
+
+EventWatchdog::EventWatchdog()
+:fMessenger(nullptr),fMaxSteps(0),fMaxTime(0.),fFileName("SlowEvents"),
+ fActive(false),fEventOffset(0),fReplayedEvent(-1),fSteps(0),fReason(kNone),fAbortedBySteps(0),fAbortedByTime(0)
+{
+  fMessenger = new WatchdogMessenger(this);
+}
+
+EventWatchdog::~EventWatchdog()
+{
+  delete fMessenger;
+}
+
+void EventWatchdog::BeginOfRun(const G4Run*, G4int eventOffset)
+{
+  fAbortedBySteps = fAbortedByTime = 0;
+  fEventOffset = eventOffset;
+  fReplayedEvent = -1;
+  fActive = (fMaxSteps > 0 || fMaxTime > 0.);
+
+  // the event keeps the engine state from before its primary generation
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  if (fActive) {
+    G4int flag = runManager->GetFlagRandomNumberStatusToG4Event();
+    if (flag == 0 || flag == 2)
+      runManager->StoreRandomNumberStatusToG4Event(flag + 1);
+  }
+
+  if (fReplayFile.empty()) return;
+  // worker engines are reseeded by the master at every event
+  if (G4Threading::IsMultithreadedApplication()) {
+    G4cout << "\n--> warning from EventWatchdog::BeginOfRun : replay needs "
+           << "the sequential run manager, " << fReplayFile << " ignored"
+           << G4endl;
+  } else {
+    std::ifstream in(fReplayFile);
+    // "event <n>" first; files without it hold the engine state only
+    std::string line, word;
+    G4int event = -1;
+    std::getline(in, line);
+    std::istringstream header(line);
+    if (!(header >> word >> event) || word != "event") {
+      event = -1;
+      in.clear();
+      in.seekg(0);
+    }
+    if (in.is_open() && G4Random::restoreFullState(in)) {
+      fReplayedEvent = event;
+      G4cout << " Random engine restored from " << fReplayFile;
+      if (event >= 0) G4cout << " for event " << event;
+      G4cout << G4endl;
+    }
+    else
+      G4cout << "\n--> warning from EventWatchdog::BeginOfRun : cannot "
+             << "restore the engine from " << fReplayFile << G4endl;
+  }
+  fReplayFile = "";
+}
+
+void EventWatchdog::BeginOfEvent()
+{
+  fSteps = 0;
+  fReason = kNone;
+  if (fActive) fStart = std::chrono::steady_clock::now();
+}
+
+G4double EventWatchdog::Elapsed() const
+{
+  return std::chrono::duration<G4double>(
+           std::chrono::steady_clock::now() - fStart).count();
+}
+
+void EventWatchdog::Abort(Reason reason)
+{
+  fReason = reason;
+  G4RunManager::GetRunManager()->AbortEvent();
+}
+
+void EventWatchdog::EndOfEvent(const G4Event* event)
+{
+  if (fReason == kNone) return;
+  if (fReason == kSteps) ++fAbortedBySteps;
+  else ++fAbortedByTime;
+
+  G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  G4int eventID = event->GetEventID();
+  G4String stateFile = fFileName + "_run" + std::to_string(runID)
+                     + "_evt" + std::to_string(eventID) + ".rndm";
+  std::ofstream state(stateFile);
+  state << "event " << eventID + fEventOffset << '\n'
+        << event->GetRandomNumberStatus();
+
+  const G4PrimaryVertex* vertex = event->GetPrimaryVertex();
+  const G4PrimaryParticle* primary = vertex ? vertex->GetPrimary() : nullptr;
+
+  G4AutoLock lock(&indexMutex);
+  std::ofstream index(fFileName + ".out",
+                      indexStarted ? std::ios::app : std::ios::out);
+  if (!indexStarted) {
+    index << "run" << '\t' << "event" << '\t' << "reason" << '\t' << "steps"
+          << '\t' << "time(s)" << '\t' << "particle" << '\t' << "energy"
+          << '\t' << "x(mm)" << '\t' << "y(mm)" << '\t' << "z(mm)" << '\t'
+          << "dx" << '\t' << "dy" << '\t' << "dz" << '\t' << "state" << '\n';
+    indexStarted = true;
+  }
+  index << runID << '\t' << eventID << '\t'
+        << (fReason == kSteps ? "steps" : "time") << '\t' << fSteps << '\t'
+        << Elapsed();
+  if (primary) {
+    const G4ThreeVector& position = vertex->GetPosition();
+    const G4ThreeVector& direction = primary->GetMomentumDirection();
+    index << '\t' << primary->GetParticleDefinition()->GetParticleName()
+          << '\t' << primary->GetKineticEnergy()/MeV
+          << '\t' << position.x()/mm << '\t' << position.y()/mm
+          << '\t' << position.z()/mm << '\t' << direction.x()
+          << '\t' << direction.y() << '\t' << direction.z();
+  }
+  index << '\t' << stateFile << '\n';
+}
+
+void EventWatchdog::EndOfRun()
+{
+  if (!fActive) return;
+  G4cout << "events over budget: " << fAbortedBySteps + fAbortedByTime
+         << " (steps: " << fAbortedBySteps << ", time: " << fAbortedByTime
+         << ")";
+  if (fAbortedBySteps + fAbortedByTime > 0)
+    G4cout << ", listed in " << fFileName << ".out";
+  G4cout << G4endl;
+}
+
+void EventWatchdog::Merge(const EventWatchdog& worker)
+{
+  fAbortedBySteps += worker.fAbortedBySteps;
+  fAbortedByTime  += worker.fAbortedByTime;
+}
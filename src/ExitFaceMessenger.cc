@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ExitFaceMessenger.cc
+/// \brief Implementation of the ExitFaceMessenger class
+//
+
+#include "ExitFaceMessenger.hh"
+
+#include "ExitFaceScorer.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+ExitFaceMessenger::ExitFaceMessenger(ExitFaceScorer* scorer)
+:G4UImessenger(),fScorer(scorer),fExitDir(nullptr),fActiveCmd(nullptr),
+ fNbinsECmd(nullptr),fNbinsACmd(nullptr),fEmaxCmd(nullptr)
+{ 
+  fExitDir = new G4UIdirectory("/testem/exit/");
+  fExitDir->SetGuidance("exit face (broad-beam) scoring commands");
+
+  fActiveCmd = new G4UIcmdWithABool("/testem/exit/activate",this);
+  fActiveCmd->SetGuidance("Score all particles leaving the slab.");
+  fActiveCmd->SetParameterName("flag",true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNbinsECmd = new G4UIcmdWithAnInteger("/testem/exit/setEnergyBins",this);
+  fNbinsECmd->SetGuidance("Set number of bins of the energy histograms.");
+  fNbinsECmd->SetParameterName("nbins",false);
+  fNbinsECmd->SetRange("nbins>0");
+  fNbinsECmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNbinsACmd = new G4UIcmdWithAnInteger("/testem/exit/setAngleBins",this);
+  fNbinsACmd->SetGuidance("Set number of bins of the angle histograms (0-90 deg).");
+  fNbinsACmd->SetParameterName("nbins",false);
+  fNbinsACmd->SetRange("nbins>0");
+  fNbinsACmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fEmaxCmd = new G4UIcmdWithADoubleAndUnit("/testem/exit/setMaxEnergy",this);
+  fEmaxCmd->SetGuidance("Set upper edge of the energy histograms.");
+  fEmaxCmd->SetGuidance("0 uses the primary energy.");
+  fEmaxCmd->SetParameterName("Emax",false);
+  fEmaxCmd->SetRange("Emax>=0.");
+  fEmaxCmd->SetUnitCategory("Energy");
+  fEmaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+ExitFaceMessenger::~ExitFaceMessenger()
+{
+  delete fActiveCmd;
+  delete fNbinsECmd;
+  delete fNbinsACmd;
+  delete fEmaxCmd;
+  delete fExitDir;
+}
+
+void ExitFaceMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fActiveCmd )
+   { fScorer->SetActive(fActiveCmd->GetNewBoolValue(newValue));}
+
+  if( command == fNbinsECmd )
+   { fScorer->SetNumberOfEnergyBins(fNbinsECmd->GetNewIntValue(newValue));}
+
+  if( command == fNbinsACmd )
+   { fScorer->SetNumberOfAngleBins(fNbinsACmd->GetNewIntValue(newValue));}
+
+  if( command == fEmaxCmd )
+   { fScorer->SetMaxEnergy(fEmaxCmd->GetNewDoubleValue(newValue));}
+}
@@ -0,0 +1,173 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ExitFaceScorer.cc
+/// \brief Implementation of the ExitFaceScorer class
+//
+
+#include "ExitFaceScorer.hh"
+#include "ExitFaceMessenger.hh"
+
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+
+ExitFaceScorer::ExitFaceScorer()
+:fMessenger(nullptr),fActive(false),fNbinsE(100),fNbinsA(90),fMaxEnergy(0.),
+ fEmax(0.),fInvBinE(0.),fInvBinA(0.),
+ fGamma(nullptr),fElectron(nullptr),fPositron(nullptr),
+ fUncollided(0.),fUncollidedEnergy(0.)
+{
+  for (G4int i = 0; i < kNumberOfSpecies; ++i) {
+    fCount[i] = fEnergySum[i] = fBackCount[i] = 0.;
+  }
+  fMessenger = new ExitFaceMessenger(this);
+}
+
+ExitFaceScorer::~ExitFaceScorer()
+{
+  delete fMessenger;
+}
+
+void ExitFaceScorer::Reset(G4double primaryEnergy)
+{
+  fGamma    = G4Gamma::Definition();
+  fElectron = G4Electron::Definition();
+  fPositron = G4Positron::Definition();
+
+  fEmax = (fMaxEnergy > 0.) ? fMaxEnergy : primaryEnergy;
+  fInvBinE = fNbinsE/fEmax;
+  fInvBinA = fNbinsA/halfpi;
+
+  fEnergyHist.assign(kNumberOfSpecies*fNbinsE, 0.);
+  fAngleHist.assign(kNumberOfSpecies*fNbinsA, 0.);
+  for (G4int i = 0; i < kNumberOfSpecies; ++i) {
+    fCount[i] = fEnergySum[i] = fBackCount[i] = 0.;
+  }
+  fUncollided = fUncollidedEnergy = 0.;
+}
+
+void ExitFaceScorer::Merge(const ExitFaceScorer& other)
+{
+  if (other.fEnergyHist.size() != fEnergyHist.size() ||
+      other.fAngleHist.size() != fAngleHist.size()) return;
+
+  for (std::size_t i = 0; i < fEnergyHist.size(); ++i)
+    fEnergyHist[i] += other.fEnergyHist[i];
+  for (std::size_t i = 0; i < fAngleHist.size(); ++i)
+    fAngleHist[i] += other.fAngleHist[i];
+  for (G4int i = 0; i < kNumberOfSpecies; ++i) {
+    fCount[i]     += other.fCount[i];
+    fEnergySum[i] += other.fEnergySum[i];
+    fBackCount[i] += other.fBackCount[i];
+  }
+  fUncollided       += other.fUncollided;
+  fUncollidedEnergy += other.fUncollidedEnergy;
+}
+
+void ExitFaceScorer::WriteState(std::ostream& os) const
+{
+  os << fEnergyHist.size() << ' ' << fAngleHist.size() << '\n';
+  for (G4double val : fEnergyHist) os << val << ' ';
+  os << '\n';
+  for (G4double val : fAngleHist) os << val << ' ';
+  os << '\n';
+  for (G4int i = 0; i < kNumberOfSpecies; ++i)
+    os << fCount[i] << ' ' << fEnergySum[i] << ' ' << fBackCount[i] << ' ';
+  os << fUncollided << ' ' << fUncollidedEnergy << '\n';
+}
+
+G4bool ExitFaceScorer::ReadState(std::istream& is)
+{
+  std::size_t nE = 0, nA = 0;
+  is >> nE >> nA;
+  if (!is || nE != fEnergyHist.size() || nA != fAngleHist.size()) return false;
+  for (G4double& val : fEnergyHist) is >> val;
+  for (G4double& val : fAngleHist) is >> val;
+  for (G4int i = 0; i < kNumberOfSpecies; ++i)
+    is >> fCount[i] >> fEnergySum[i] >> fBackCount[i];
+  is >> fUncollided >> fUncollidedEnergy;
+  return bool(is);
+}
+
+void ExitFaceScorer::Write(G4double numberOfEvents) const
+{
+  if (numberOfEvents <= 0.) return;
+
+  static const char* names[kNumberOfSpecies] = {"gamma", "e-", "e+", "other"};
+
+  // narrow beam = uncollided photons only; broad beam = every photon
+  // leaving the downstream face
+  G4double narrow = fUncollided/numberOfEvents;
+  G4double broad  = fCount[kGamma]/numberOfEvents;
+  G4double numberBuildup = (fUncollided > 0.) ? fCount[kGamma]/fUncollided : 0.;
+  G4double energyBuildup =
+    (fUncollidedEnergy > 0.) ? fEnergySum[kGamma]/fUncollidedEnergy : 0.;
+
+  G4cout << "\n Exit face: narrow-beam transmission " << narrow
+         << ", broad-beam transmission " << broad
+         << ", buildup (number) " << numberBuildup
+         << ", buildup (energy) " << energyBuildup << G4endl;
+
+  std::ofstream ofs("ExitFace.out");
+  if (!ofs.is_open()) {
+    G4cout << "Exit face file is not open!!!!" << G4endl;
+    return;
+  }
+
+  ofs << "# events" << '\t' << numberOfEvents << '\n';
+  ofs << "# narrowBeamTransmission" << '\t' << narrow << '\n';
+  ofs << "# broadBeamTransmission" << '\t' << broad << '\n';
+  ofs << "# numberBuildup" << '\t' << numberBuildup << '\n';
+  ofs << "# energyBuildup" << '\t' << energyBuildup << '\n';
+  for (G4int s = 0; s < kNumberOfSpecies; ++s) {
+    ofs << "# " << names[s] << '\t' << "forward" << '\t' << fCount[s]
+        << '\t' << "energy" << '\t' << fEnergySum[s]/MeV
+        << '\t' << "backward" << '\t' << fBackCount[s] << '\n';
+  }
+
+  ofs << "energy";
+  for (G4int s = 0; s < kNumberOfSpecies; ++s) ofs << '\t' << names[s];
+  ofs << '\n';
+  for (G4int i = 0; i < fNbinsE; ++i) {
+    ofs << (i+0.5)*fEmax/fNbinsE/MeV;
+    for (G4int s = 0; s < kNumberOfSpecies; ++s)
+      ofs << '\t' << fEnergyHist[s*fNbinsE + i];
+    ofs << '\n';
+  }
+
+  ofs << "angle";
+  for (G4int s = 0; s < kNumberOfSpecies; ++s) ofs << '\t' << names[s];
+  ofs << '\n';
+  for (G4int i = 0; i < fNbinsA; ++i) {
+    ofs << (i+0.5)*halfpi/fNbinsA/deg;
+    for (G4int s = 0; s < kNumberOfSpecies; ++s)
+      ofs << '\t' << fAngleHist[s*fNbinsA + i];
+    ofs << '\n';
+  }
+}
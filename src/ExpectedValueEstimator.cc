@@ -0,0 +1,173 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ExpectedValueEstimator.cc
+/// \brief Implementation of the ExpectedValueEstimator class
+//
+
+#include "ExpectedValueEstimator.hh"
+#include "ExpectedValueMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "CTPhantom.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4Track.hh"
+#include "G4Material.hh"
+#include "G4Gamma.hh"
+#include "G4VSolid.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4NavigationHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+ExpectedValueEstimator::ExpectedValueEstimator(DetectorConstruction* det)
+:fDetector(det),fMessenger(nullptr),fRequested(false),fActive(false),
+ fCollided(false),fDepth(0.),fScore(0.),fEvents(0.),fSum(0.),fSum2(0.)
+{
+  fMessenger = new ExpectedValueMessenger(this);
+}
+
+ExpectedValueEstimator::~ExpectedValueEstimator()
+{
+  delete fMessenger;
+}
+
+void ExpectedValueEstimator::BeginOfRun(const G4ParticleDefinition* particle)
+{
+  fActive = fRequested;
+  if (fActive && fDetector->GetPhantom()->IsActive()) {
+    G4cout << "\n--> warning from ExpectedValueEstimator::BeginOfRun : "
+           << "no expected-value estimate through the CT phantom"
+           << G4endl;
+    fActive = false;
+  }
+  // no hadronic cross section in Sigma
+  if (fActive && particle != G4Gamma::Gamma()) {
+    if (G4Threading::IsMasterThread())
+      G4cout << "\n--> warning from ExpectedValueEstimator::BeginOfRun : "
+             << "gamma beams only, no expected-value estimate for "
+             << (particle ? particle->GetParticleName() : G4String("no particle"))
+             << G4endl;
+    fActive = false;
+  }
+
+  // materials or tables may have changed since the previous run
+  fSigma.clear();
+  fEvents = fSum = fSum2 = 0.;
+}
+
+void ExpectedValueEstimator::Score(const G4Step* step)
+{
+  const G4StepPoint* point = step->GetPreStepPoint();
+  const G4Material* material = point->GetMaterial();
+  G4double energy = point->GetKineticEnergy();
+  auto key = std::make_pair(material, energy);
+  auto cached = fSigma.find(key);
+  if (cached == fSigma.end())
+    cached = fSigma.emplace(key, fCalculator.GetCrossSectionPerVolume(
+               step->GetTrack()->GetDefinition(), energy, material)).first;
+  G4double sigma = cached->second;
+
+  // distance to the exit of the current volume, in its own frame
+  const G4AffineTransform& transform =
+    point->GetTouchableHandle()->GetHistory()->GetTopTransform();
+  G4ThreeVector position = transform.TransformPoint(point->GetPosition());
+  G4ThreeVector direction =
+    transform.TransformAxis(point->GetMomentumDirection());
+  G4double distance = point->GetPhysicalVolume()->GetLogicalVolume()
+                        ->GetSolid()->DistanceToOut(position, direction);
+  fScore = std::exp(-(fDepth + sigma*distance));
+
+  // a change of energy or direction ends the uncollided path
+  const G4StepPoint* post = step->GetPostStepPoint();
+  if (post->GetKineticEnergy() != energy ||
+      post->GetMomentumDirection() != point->GetMomentumDirection()) {
+    fCollided = true;
+    return;
+  }
+  fDepth += sigma*step->GetStepLength();
+}
+
+void ExpectedValueEstimator::Merge(const ExpectedValueEstimator& worker)
+{
+  if (!fActive) return;
+  fEvents += worker.fEvents;
+  fSum    += worker.fSum;
+  fSum2   += worker.fSum2;
+}
+
+void ExpectedValueEstimator::WriteState(std::ostream& os) const
+{
+  os << fEvents << ' ' << fSum << ' ' << fSum2 << '\n';
+}
+
+G4bool ExpectedValueEstimator::ReadState(std::istream& is)
+{
+  G4double events = 0., sum = 0., sum2 = 0.;
+  is >> events >> sum >> sum2;
+  if (!is) return false;
+  fEvents = events;
+  fSum = sum;
+  fSum2 = sum2;
+  return true;
+}
+
+void ExpectedValueEstimator::EndOfRun(G4double energy, G4double transmitted,
+                                      G4double events)
+{
+  if (!fActive || fEvents <= 0.) return;
+
+  G4double counting = transmitted/events;
+  G4double countingError = std::sqrt(counting*(1.-counting)/events);
+  G4double expected = fSum/fEvents;
+  G4double expectedError =
+    std::sqrt(std::max(0., fSum2/fEvents - expected*expected)/fEvents);
+
+  // a mu/rho for the homogeneous slab only, not across lanes
+  G4double mu = 0., muError = 0.;
+  if (expected > 0. && fDetector->GetNumberOfLanes() == 0) {
+    G4double areaDensity = fDetector->GetSize()*fDetector->GetDensity();
+    mu = -std::log(expected)/areaDensity;
+    muError = expectedError/(expected*areaDensity);
+  }
+
+  G4double error = std::sqrt(countingError*countingError +
+                             expectedError*expectedError);
+  G4cout << "transmission, counting: " << counting << " +- " << countingError
+         << ", expected value: " << expected << " +- " << expectedError;
+  if (error > 0.)
+    G4cout << " (" << (counting - expected)/error << " sigma apart)";
+  G4cout << G4endl;
+
+  WriteOutputFile::GetInstance() -> FillExpectedValue(energy/MeV, counting,
+                    countingError, expected, expectedError,
+                    mu/(cm*cm/g), muError/(cm*cm/g));
+}
@@ -0,0 +1,59 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ExpectedValueMessenger.cc
+/// \brief Implementation of the ExpectedValueMessenger class
+//
+
+#include "ExpectedValueMessenger.hh"
+
+#include "ExpectedValueEstimator.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+
+ExpectedValueMessenger::ExpectedValueMessenger(ExpectedValueEstimator* estimator)
+:G4UImessenger(),fEstimator(estimator),fExpectedDir(nullptr),fActivateCmd(nullptr)
+{ 
+  fExpectedDir = new G4UIdirectory("/testem/expected/");
+  fExpectedDir->SetGuidance("expected-value transmission estimator");
+
+  fActivateCmd = new G4UIcmdWithABool("/testem/expected/activate",this);
+  fActivateCmd->SetGuidance("Score exp(-Sigma L) at the entry of each primary,");
+  fActivateCmd->SetGuidance("next to the count of transmitted primaries.");
+  fActivateCmd->SetParameterName("flag",true);
+  fActivateCmd->SetDefaultValue(true);
+  fActivateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+ExpectedValueMessenger::~ExpectedValueMessenger()
+{
+  delete fActivateCmd;
+  delete fExpectedDir;
+}
+
+void ExpectedValueMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fActivateCmd )
+   { fEstimator->SetActive(fActivateCmd->GetNewBoolValue(newValue));}
+}
@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/MemoryMessenger.cc
+/// \brief Implementation of the MemoryMessenger class
+//
+
+#include "MemoryMessenger.hh"
+
+#include "MemoryReport.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+MemoryMessenger::MemoryMessenger(MemoryReport* report)
+:G4UImessenger(),fReport(report),fMemoryDir(nullptr),fActivateCmd(nullptr),
+ fFileCmd(nullptr),fReportCmd(nullptr)
+{ 
+  fMemoryDir = new G4UIdirectory("/testem/memory/");
+  fMemoryDir->SetGuidance("memory accounting");
+
+  fActivateCmd = new G4UIcmdWithABool("/testem/memory/activate",this);
+  fActivateCmd->SetGuidance("Report memory at start and end of each run.");
+  fActivateCmd->SetParameterName("flag",true);
+  fActivateCmd->SetDefaultValue(true);
+  fActivateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/memory/setFileName",this);
+  fFileCmd->SetGuidance("Set name of the memory report file.");
+  fFileCmd->SetParameterName("file",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fReportCmd = new G4UIcmdWithoutParameter("/testem/memory/report",this);
+  fReportCmd->SetGuidance("Write a memory report now.");
+  fReportCmd->AvailableForStates(G4State_Idle);
+}
+
+MemoryMessenger::~MemoryMessenger()
+{
+  delete fActivateCmd;
+  delete fFileCmd;
+  delete fReportCmd;
+  delete fMemoryDir;
+}
+
+void MemoryMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fActivateCmd )
+   { fReport->SetActive(fActivateCmd->GetNewBoolValue(newValue));}
+
+  if( command == fFileCmd )
+   { fReport->SetFileName(newValue);}
+
+  if( command == fReportCmd )
+   { fReport->Report("on request");}
+}
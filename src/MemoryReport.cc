@@ -0,0 +1,227 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/MemoryReport.cc
+/// \brief Implementation of the MemoryReport class
+//
+
+#include "MemoryReport.hh"
+#include "MemoryMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "CTPhantom.hh"
+
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4PhysicsTable.hh"
+#include "G4PhysicsVector.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4MaterialCutsCouple.hh"
+#include "G4Material.hh"
+#include "G4SolidStore.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4VSolid.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Threading.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+
+namespace {
+
+// "VmRSS:   1234 kB" lines of /proc/self/status, in kB; -1 if missing
+G4double ProcStatus(const char* key)
+{
+  std::ifstream in("/proc/self/status");
+  std::string line;
+  std::size_t length = std::strlen(key);
+  while (std::getline(in, line)) {
+    if (line.compare(0, length, key) == 0)
+      return std::atof(line.c_str() + length + 1);
+  }
+  return -1.;
+}
+
+// the data of a physics vector: energies and values, without splines
+G4double TableBytes(const G4PhysicsTable* table,
+                    std::vector<G4double>& perCouple)
+{
+  if (!table) return 0.;
+  G4double bytes = 0.;
+  for (std::size_t i = 0; i < table->size(); ++i) {
+    const G4PhysicsVector* vec = (*table)[i];
+    if (!vec) continue;
+    G4double size = sizeof(G4PhysicsVector)
+                  + 2.*sizeof(G4double)*vec->GetVectorLength();
+    bytes += size;
+    if (i < perCouple.size()) perCouple[i] += size;
+  }
+  return bytes;
+}
+
+}
+
+MemoryReport::MemoryReport(DetectorConstruction* det)
+:fDetector(det),fMessenger(nullptr),fActive(false),
+ fFileName("MemoryReport.out"),fFileStarted(false),fStackHighWater(0)
+{
+  fMessenger = new MemoryMessenger(this);
+}
+
+MemoryReport::~MemoryReport()
+{
+  delete fMessenger;
+}
+
+void MemoryReport::BeginOfRun(G4int runID)
+{
+  fStackHighWater = 0;
+  if (fActive && G4Threading::IsMasterThread()) Report("after initialization, run " + std::to_string(runID));
+}
+
+void MemoryReport::EndOfRun(G4int runID)
+{
+  if (fActive && G4Threading::IsMasterThread()) Report("end of run " + std::to_string(runID));
+}
+
+void MemoryReport::Report(const G4String& label)
+{
+  std::ofstream out(fFileName, fFileStarted ? std::ios::app : std::ios::out);
+  if (!out.is_open()) {
+    G4cout << "\n--> warning from MemoryReport::Report : cannot open "
+           << fFileName << G4endl;
+    return;
+  }
+  fFileStarted = true;
+
+  out << "# " << label << '\n';
+  WriteProcessMemory(out);
+  WriteEmTables(out);
+  WriteGeometry(out);
+  out << "stack high-water mark (tracks)" << '\t' << fStackHighWater << '\n';
+  out << '\n';
+
+  G4cout << "memory (" << label << "): RSS " << ProcStatus("VmRSS:")/1024.
+         << " MB, peak " << ProcStatus("VmHWM:")/1024. << " MB" << G4endl;
+}
+
+void MemoryReport::WriteProcessMemory(std::ostream& out) const
+{
+  // Linux first; elsewhere only the peak from getrusage
+  G4double rss = ProcStatus("VmRSS:");
+  G4double peak = ProcStatus("VmHWM:");
+  if (peak < 0.) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) peak = usage.ru_maxrss;
+  }
+  out << "RSS current (kB)" << '\t' << rss << '\n';
+  out << "RSS peak (kB)" << '\t' << peak << '\n';
+}
+
+void MemoryReport::WriteEmTables(std::ostream& out) const
+{
+  G4ProductionCutsTable* cuts = G4ProductionCutsTable::GetProductionCutsTable();
+  std::size_t nCouples = cuts->GetTableSize();
+  std::vector<G4double> perCouple(nCouples, 0.);
+
+  // tables shared between particles are counted once
+  std::set<const G4PhysicsTable*> seen;
+  auto count = [&](const G4PhysicsTable* table) {
+    if (!table || !seen.insert(table).second) return 0.;
+    return TableBytes(table, perCouple);
+  };
+
+  out << "EM tables (bytes, estimate)" << '\t' << "particle" << '\t'
+      << "process" << '\n';
+  G4double total = 0.;
+  auto iterator = G4ParticleTable::GetParticleTable()->GetIterator();
+  iterator->reset();
+  while ((*iterator)()) {
+    G4ParticleDefinition* particle = iterator->value();
+    G4ProcessManager* manager = particle->GetProcessManager();
+    if (!manager) continue;
+    G4ProcessVector* processes = manager->GetProcessList();
+    for (std::size_t i = 0; i < processes->size(); ++i) {
+      G4VProcess* process = (*processes)[i];
+      if (process->GetProcessType() != fElectromagnetic) continue;
+
+      G4double bytes = 0.;
+      if (auto* loss = dynamic_cast<G4VEnergyLossProcess*>(process)) {
+        bytes += count(loss->DEDXTable());
+        bytes += count(loss->RangeTableForLoss());
+        bytes += count(loss->InverseRangeTable());
+        bytes += count(loss->CSDARangeTable());
+        bytes += count(loss->LambdaTable());
+      }
+      else if (auto* em = dynamic_cast<G4VEmProcess*>(process)) {
+        bytes += count(em->LambdaTable());
+        bytes += count(em->LambdaTablePrim());
+      }
+      if (bytes <= 0.) continue;
+      out << bytes << '\t' << particle->GetParticleName() << '\t'
+          << process->GetProcessName() << '\n';
+      total += bytes;
+    }
+  }
+  out << total << '\t' << "all" << '\t' << "all" << '\n';
+
+  // a couple is a material with a set of cuts
+  std::map<G4String, G4double> perMaterial;
+  for (std::size_t i = 0; i < nCouples; ++i)
+    perMaterial[cuts->GetMaterialCutsCouple(i)->GetMaterial()->GetName()]
+      += perCouple[i];
+  out << "EM tables per material (bytes)" << '\t' << "material" << '\n';
+  for (const auto& entry : perMaterial)
+    out << entry.second << '\t' << entry.first << '\n';
+}
+
+void MemoryReport::WriteGeometry(std::ostream& out) const
+{
+  std::size_t nSolids = G4SolidStore::GetInstance()->size();
+  std::size_t nLogical = G4LogicalVolumeStore::GetInstance()->size();
+  std::size_t nPhysical = G4PhysicalVolumeStore::GetInstance()->size();
+  out << "solids" << '\t' << nSolids << '\n';
+  out << "logical volumes" << '\t' << nLogical << '\n';
+  out << "physical volumes" << '\t' << nPhysical << '\n';
+  out << "materials" << '\t' << G4Material::GetNumberOfMaterials() << '\n';
+
+  // the voxel to material index map of the parameterisation
+  const CTPhantom* phantom = fDetector->GetPhantom();
+  if (phantom->IsActive()) {
+    G4double voxels = G4double(phantom->GetNx())*phantom->GetNy()*phantom->GetNz();
+    out << "phantom voxel index (bytes)" << '\t' << voxels*sizeof(std::size_t)
+        << '\n';
+  }
+}
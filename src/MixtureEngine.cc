@@ -0,0 +1,219 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/MixtureEngine.cc
+/// \brief Implementation of the MixtureEngine class
+//
+
+#include "MixtureEngine.hh"
+#include "MixtureEngineMessenger.hh"
+#include "AttenuationCalculator.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4NistManager.hh"
+#include "G4Material.hh"
+#include "G4Timer.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+// heaviest element with a NIST simple material
+const G4int kMaxZ = 98;
+}
+
+MixtureEngine::MixtureEngine(PrimaryGeneratorAction* prim)
+:fPrimary(prim),fMessenger(nullptr),fCalculator(nullptr),
+ fEnergyMin(10*keV),fEnergyMax(10*MeV),fNumberOfPoints(100),
+ fTableParticle(nullptr)
+{
+  fMessenger = new MixtureEngineMessenger(this);
+  fCalculator = new AttenuationCalculator();
+}
+
+MixtureEngine::~MixtureEngine()
+{
+  delete fCalculator;
+  delete fMessenger;
+}
+
+void MixtureEngine::SetEnergyMin(G4double val)
+{
+  fEnergyMin = val;
+  fEnergies.clear();
+}
+
+void MixtureEngine::SetEnergyMax(G4double val)
+{
+  fEnergyMax = val;
+  fEnergies.clear();
+}
+
+void MixtureEngine::SetNumberOfPoints(G4int val)
+{
+  fNumberOfPoints = val;
+  fEnergies.clear();
+}
+
+void MixtureEngine::ResetTables()
+{
+  G4int nE = fNumberOfPoints;
+  fEnergies.resize(nE);
+  G4double ratio = std::log(fEnergyMax/fEnergyMin)/std::max(nE-1, 1);
+  for (G4int i = 0; i < nE; ++i)
+    fEnergies[i] = fEnergyMin*std::exp(i*ratio);
+
+  fTableParticle = fPrimary->GetParticleGun()->GetParticleDefinition();
+  fTable.assign((std::size_t)kMaxZ*nE, 0.);
+  fRowBuilt.assign(kMaxZ, false);
+}
+
+void MixtureEngine::BuildElement(G4int Z)
+{
+  if (fRowBuilt[Z-1]) return;
+
+  // mu/rho of a pure element does not depend on its density or state
+  G4Material* element =
+    G4NistManager::Instance()->FindOrBuildSimpleMaterial(Z);
+  G4int nE = fEnergies.size();
+  G4double* row = &fTable[(std::size_t)(Z-1)*nE];
+  for (G4int i = 0; i < nE; ++i)
+    row[i] = fCalculator->ComputeMassAttenuation(fTableParticle,
+                                                 fEnergies[i], element);
+  fRowBuilt[Z-1] = true;
+}
+
+void MixtureEngine::Evaluate(const Composition& mix, G4double* muOverRho) const
+{
+  const std::size_t nE = fEnergies.size();
+  std::fill(muOverRho, muOverRho + nE, 0.);
+
+  // one axpy per element over contiguous energies: vectorises
+  for (std::size_t k = 0; k < mix.Z.size(); ++k) {
+    const G4double* __restrict row = &fTable[(std::size_t)(mix.Z[k]-1)*nE];
+    G4double* __restrict out = muOverRho;
+    const G4double w = mix.fraction[k];
+    for (std::size_t i = 0; i < nE; ++i) out[i] += w*row[i];
+  }
+}
+
+G4bool MixtureEngine::ParseLine(const G4String& line, Composition& mix) const
+{
+  std::istringstream is(line);
+  if (!(is >> mix.name)) return false;
+
+  G4NistManager* nist = G4NistManager::Instance();
+  mix.Z.clear();
+  mix.fraction.clear();
+  G4String symbol;
+  G4double fraction;
+  while (is >> symbol >> fraction) {
+    G4int Z = nist->GetZ(symbol);
+    if (Z < 1 || Z > kMaxZ || fraction < 0.) {
+      G4cout << "\n--> warning from MixtureEngine::ParseLine : " << mix.name
+             << " : bad component " << symbol << " " << fraction
+             << ", compound skipped" << G4endl;
+      return false;
+    }
+    mix.Z.push_back(Z);
+    mix.fraction.push_back(fraction);
+  }
+
+  G4double sum = 0.;
+  for (G4double w : mix.fraction) sum += w;
+  if (mix.Z.empty() || sum <= 0.) {
+    G4cout << "\n--> warning from MixtureEngine::ParseLine : " << mix.name
+           << " has no components, compound skipped" << G4endl;
+    return false;
+  }
+  if (std::abs(sum - 1.) > 1.e-3)
+    G4cout << "\n--> warning from MixtureEngine::ParseLine : " << mix.name
+           << " fractions sum to " << sum << ", renormalised" << G4endl;
+  for (G4double& w : mix.fraction) w /= sum;
+  return true;
+}
+
+void MixtureEngine::ProcessFile(const G4String& fileName)
+{
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    G4cout << "\n--> warning from MixtureEngine::ProcessFile : cannot open "
+           << fileName << G4endl;
+    return;
+  }
+  if (fEnergyMin <= 0. || fEnergyMax <= fEnergyMin || fNumberOfPoints < 2) {
+    G4cout << "\n--> warning from MixtureEngine::ProcessFile : invalid range "
+           << G4BestUnit(fEnergyMin,"Energy") << " - "
+           << G4BestUnit(fEnergyMax,"Energy") << G4endl;
+    return;
+  }
+
+  std::vector<Composition> mixes;
+  G4String line;
+  while (std::getline(in, line)) {
+    std::size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+    Composition mix;
+    if (ParseLine(line, mix)) mixes.push_back(mix);
+  }
+
+  // the cross sections need the physics tables
+  G4RunManager::GetRunManager()->BeamOn(0);
+
+  if (fEnergies.empty() ||
+      fTableParticle != fPrimary->GetParticleGun()->GetParticleDefinition())
+    ResetTables();
+
+  G4Timer timer;
+  timer.Start();
+  for (const Composition& mix : mixes)
+    for (G4int Z : mix.Z) BuildElement(Z);
+  timer.Stop();
+  G4double tableTime = timer.GetRealElapsed();
+
+  std::size_t nE = fEnergies.size();
+  std::vector<G4double> muOverRho(nE*mixes.size());
+  timer.Start();
+  for (std::size_t m = 0; m < mixes.size(); ++m)
+    Evaluate(mixes[m], &muOverRho[m*nE]);
+  timer.Stop();
+
+  G4cout << "mixture rule: " << mixes.size() << " compounds x " << nE
+         << " energies in " << timer.GetRealElapsed() << " s"
+         << " (element tables " << tableTime << " s)" << G4endl;
+
+  WriteOutputFile* output = WriteOutputFile::GetInstance();
+  for (std::size_t m = 0; m < mixes.size(); ++m)
+    for (std::size_t i = 0; i < nE; ++i)
+      output -> FillMixture(mixes[m].name, fEnergies[i]/MeV,
+                            muOverRho[m*nE + i]/(cm*cm/g));
+}
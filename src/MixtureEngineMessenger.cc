@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/MixtureEngineMessenger.cc
+/// \brief Implementation of the MixtureEngineMessenger class
+//
+
+#include "MixtureEngineMessenger.hh"
+
+#include "MixtureEngine.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+
+MixtureEngineMessenger::MixtureEngineMessenger(MixtureEngine* engine)
+:G4UImessenger(),fEngine(engine),fMixDir(nullptr),fEminCmd(nullptr),
+ fEmaxCmd(nullptr),fPointsCmd(nullptr),fProcessCmd(nullptr)
+{ 
+  fMixDir = new G4UIdirectory("/testem/mix/");
+  fMixDir->SetGuidance("mixture-rule attenuation of compounds");
+
+  fEminCmd = new G4UIcmdWithADoubleAndUnit("/testem/mix/setEmin",this);
+  fEminCmd->SetGuidance("Set lower end of the energy grid.");
+  fEminCmd->SetParameterName("Emin",false);
+  fEminCmd->SetRange("Emin>0.");
+  fEminCmd->SetUnitCategory("Energy");
+  fEminCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEminCmd->SetToBeBroadcasted(false);
+
+  fEmaxCmd = new G4UIcmdWithADoubleAndUnit("/testem/mix/setEmax",this);
+  fEmaxCmd->SetGuidance("Set upper end of the energy grid.");
+  fEmaxCmd->SetParameterName("Emax",false);
+  fEmaxCmd->SetRange("Emax>0.");
+  fEmaxCmd->SetUnitCategory("Energy");
+  fEmaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEmaxCmd->SetToBeBroadcasted(false);
+
+  fPointsCmd = new G4UIcmdWithAnInteger("/testem/mix/setPoints",this);
+  fPointsCmd->SetGuidance("Set number of log-spaced energies of the grid.");
+  fPointsCmd->SetParameterName("n",false);
+  fPointsCmd->SetRange("n>1");
+  fPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPointsCmd->SetToBeBroadcasted(false);
+
+  fProcessCmd = new G4UIcmdWithAString("/testem/mix/process",this);
+  fProcessCmd->SetGuidance("Compute mu/rho of every compound of a file,");
+  fProcessCmd->SetGuidance("one 'name symbol fraction ...' per line.");
+  fProcessCmd->SetParameterName("file",false);
+  fProcessCmd->AvailableForStates(G4State_Idle);
+  fProcessCmd->SetToBeBroadcasted(false);
+}
+
+MixtureEngineMessenger::~MixtureEngineMessenger()
+{
+  delete fEminCmd;
+  delete fEmaxCmd;
+  delete fPointsCmd;
+  delete fProcessCmd;
+  delete fMixDir;
+}
+
+void MixtureEngineMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fEminCmd )
+   { fEngine->SetEnergyMin(fEminCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEmaxCmd )
+   { fEngine->SetEnergyMax(fEmaxCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fPointsCmd )
+   { fEngine->SetNumberOfPoints(fPointsCmd->GetNewIntValue(newValue));}
+
+  if( command == fProcessCmd )
+   { fEngine->ProcessFile(newValue);}
+}
@@ -0,0 +1,321 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/PerturbationEstimator.cc
+/// \brief Implementation of the PerturbationEstimator class
+//
+
+#include "PerturbationEstimator.hh"
+#include "PerturbationMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "CTPhantom.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4Material.hh"
+#include "G4Element.hh"
+#include "G4NistManager.hh"
+#include "G4VProcess.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+PerturbationEstimator::PerturbationEstimator(DetectorConstruction* det)
+:fDetector(det),fMessenger(nullptr),fActive(false),fMaterial(nullptr),
+ fEvents(0.),fInteracted(false),fTransmitted(0.)
+{
+  fMessenger = new PerturbationMessenger(this);
+}
+
+PerturbationEstimator::~PerturbationEstimator()
+{
+  delete fMessenger;
+}
+
+void PerturbationEstimator::AddDensity(G4double factor)
+{
+  Perturbation perturbation;
+  std::ostringstream name;
+  name << "density*" << factor;
+  perturbation.name = name.str();
+  perturbation.densityFactor = factor;
+  fPerturbations.push_back(perturbation);
+}
+
+void PerturbationEstimator::AddComposition(const G4String& name, G4int Z,
+                                           G4double delta)
+{
+  for (auto& perturbation : fPerturbations) {
+    if (perturbation.name != name) continue;
+    perturbation.deltas.push_back(std::make_pair(Z, delta));
+    return;
+  }
+  Perturbation perturbation;
+  perturbation.name = name;
+  perturbation.densityFactor = 1.;
+  perturbation.deltas.push_back(std::make_pair(Z, delta));
+  fPerturbations.push_back(perturbation);
+}
+
+void PerturbationEstimator::Clear()
+{
+  fPerturbations.clear();
+}
+
+void PerturbationEstimator::BeginOfRun(const G4ParticleDefinition* particle,
+                                       const std::vector<G4double>& energies,
+                                       const PerturbationEstimator* master)
+{
+  fActive = !fPerturbations.empty();
+  if (fActive &&
+      (fDetector->GetPhantom()->IsActive() || fDetector->GetNumberOfLanes() > 0)) {
+    G4cout << "\n--> warning from PerturbationEstimator::BeginOfRun : "
+           << "homogeneous slab only, perturbations ignored in this run"
+           << G4endl;
+    fActive = false;
+  }
+
+  // the material may have changed since the previous run
+  fMaterial = fDetector->GetMaterial();
+  fElements.clear();
+  fNominal.clear();
+  fFractions.clear();
+  fDeltaSigma.clear();
+
+  if (fActive && master) {
+    fElements   = master->fElements;
+    fNominal    = master->fNominal;
+    fFractions  = master->fFractions;
+    fDeltaSigma = master->fDeltaSigma;
+  }
+  else if (fActive) {
+    // new materials only here, never while the workers track
+    fNominal = NominalFractions();
+    G4NistManager* nist = G4NistManager::Instance();
+    for (const auto& perturbation : fPerturbations) {
+      fFractions.push_back(Fractions(perturbation));
+      for (const auto& element : fFractions.back())
+        if (!fElements.count(element.first))
+          fElements[element.first] =
+            nist->FindOrBuildSimpleMaterial(element.first);
+    }
+    for (G4double energy : energies)
+      fDeltaSigma[energy] = ComputeDeltaSigma(particle, energy);
+  }
+
+  fEvents = 0.;
+  fTransmitted = 0.;
+  fSumW.assign(fPerturbations.size(), 0.);
+  fSumW2.assign(fPerturbations.size(), 0.);
+  fInteractions.clear();
+}
+
+void PerturbationEstimator::BeginOfEvent()
+{
+  if (!fActive) return;
+  fEvents += 1.;
+  fInteracted = false;
+}
+
+void PerturbationEstimator::CountInteraction(const G4VProcess* process)
+{
+  if (fInteracted) return;
+  fInteractions[process->GetProcessName()] += 1.;
+  fInteracted = true;
+}
+
+void PerturbationEstimator::ScoreUncollided(const G4ParticleDefinition* particle,
+                                            G4double energy, G4double path)
+{
+  if (!fActive) return;
+  fTransmitted += 1.;
+  const std::vector<G4double>& deltaSigma = DeltaSigma(particle, energy);
+  for (std::size_t i = 0; i < deltaSigma.size(); ++i) {
+    G4double w = std::exp(-deltaSigma[i]*path);
+    fSumW[i]  += w;
+    fSumW2[i] += w*w;
+  }
+}
+
+const std::vector<G4double>& PerturbationEstimator::DeltaSigma(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy)
+{
+  // tabulated at the start of the run: a single energy, or the bins of a
+  // spectrum; any other one from the elements already built
+  auto cached = fDeltaSigma.find(energy);
+  if (cached != fDeltaSigma.end()) return cached->second;
+  return fDeltaSigma[energy] = ComputeDeltaSigma(particle, energy);
+}
+
+std::vector<G4double> PerturbationEstimator::ComputeDeltaSigma(
+                                  const G4ParticleDefinition* particle,
+                                  G4double energy)
+{
+  // Sigma' - Sigma = rho sum_i (f w'_i - w_i) (mu/rho)_i: zero term by
+  // term for a null perturbation
+  std::map<G4int,G4double> massAttenuation;
+  for (const auto& element : fElements)
+    massAttenuation[element.first] =
+      fCalculator.ComputeMassAttenuation(particle, energy, element.second);
+  G4double density = fMaterial->GetDensity();
+
+  std::vector<G4double> deltaSigma(fPerturbations.size(), 0.);
+  for (std::size_t i = 0; i < fPerturbations.size(); ++i) {
+    G4double f = fPerturbations[i].densityFactor;
+    for (const auto& element : fFractions[i]) {
+      auto nominal = fNominal.find(element.first);
+      G4double w = (nominal != fNominal.end()) ? nominal->second : 0.;
+      deltaSigma[i] += density*(f*element.second - w)*
+                       massAttenuation[element.first];
+    }
+  }
+  return deltaSigma;
+}
+
+std::map<G4int,G4double> PerturbationEstimator::NominalFractions() const
+{
+  // an element may appear twice in a material (isotope compositions)
+  std::map<G4int,G4double> fractions;
+  const G4ElementVector* elements = fMaterial->GetElementVector();
+  const G4double* nominal = fMaterial->GetFractionVector();
+  for (std::size_t j = 0; j < fMaterial->GetNumberOfElements(); ++j)
+    fractions[(*elements)[j]->GetZasInt()] += nominal[j];
+  return fractions;
+}
+
+std::map<G4int,G4double> PerturbationEstimator::Fractions(
+                                  const Perturbation& perturbation) const
+{
+  std::map<G4int,G4double> fractions = NominalFractions();
+  if (perturbation.deltas.empty()) return fractions;
+  G4double sum = 0.;
+  for (const auto& delta : perturbation.deltas) {
+    G4double& fraction = fractions[delta.first];
+    fraction = std::max(0., fraction + delta.second);
+  }
+  for (const auto& fraction : fractions) sum += fraction.second;
+  if (sum > 0.)
+    for (auto& fraction : fractions) fraction.second /= sum;
+  return fractions;
+}
+
+void PerturbationEstimator::Merge(const PerturbationEstimator& worker)
+{
+  if (!fActive) return;
+  fEvents      += worker.fEvents;
+  fTransmitted += worker.fTransmitted;
+  for (std::size_t i = 0; i < fSumW.size() && i < worker.fSumW.size(); ++i) {
+    fSumW[i]  += worker.fSumW[i];
+    fSumW2[i] += worker.fSumW2[i];
+  }
+  for (const auto& interaction : worker.fInteractions)
+    fInteractions[interaction.first] += interaction.second;
+}
+
+void PerturbationEstimator::WriteState(std::ostream& os) const
+{
+  os << fEvents << ' ' << fTransmitted << ' ' << fSumW.size();
+  for (std::size_t i = 0; i < fSumW.size(); ++i)
+    os << ' ' << fSumW[i] << ' ' << fSumW2[i];
+  os << ' ' << fInteractions.size();
+  for (const auto& interaction : fInteractions)
+    os << ' ' << interaction.first << ' ' << interaction.second;
+  os << '\n';
+}
+
+G4bool PerturbationEstimator::ReadState(std::istream& is)
+{
+  // the perturbations must be those of the checkpointed run
+  G4double events = 0., transmitted = 0.;
+  std::size_t n = 0, nInteractions = 0;
+  is >> events >> transmitted >> n;
+  if (!is || n != fSumW.size()) return false;
+  std::vector<G4double> sumW(n), sumW2(n);
+  for (std::size_t i = 0; i < n; ++i) is >> sumW[i] >> sumW2[i];
+  std::map<G4String, G4double> interactions;
+  is >> nInteractions;
+  for (std::size_t i = 0; i < nInteractions && is; ++i) {
+    std::string name;
+    G4double count = 0.;
+    is >> name >> count;
+    interactions[name] = count;
+  }
+  if (!is) return false;
+
+  fEvents = events;
+  fTransmitted = transmitted;
+  fSumW = sumW;
+  fSumW2 = sumW2;
+  fInteractions = interactions;
+  return true;
+}
+
+void PerturbationEstimator::EndOfRun()
+{
+  if (!fActive || fEvents <= 0.) return;
+
+  G4double N = fEvents;
+  G4double thickness = fDetector->GetSize();
+  G4double density = fMaterial->GetDensity();
+  G4double transmission = fTransmitted/N;
+
+  G4cout << "\n perturbed slabs, reweighted from " << N << " events"
+         << " (nominal transmission " << transmission << ")" << G4endl;
+  WriteOutputFile* output = WriteOutputFile::GetInstance();
+  for (std::size_t i = 0; i < fPerturbations.size(); ++i) {
+    // mean weight, and its difference to the nominal transmission on the
+    // same events: sum (w-1)^2 over the transmitted ones
+    G4double T  = fSumW[i]/N;
+    G4double errT = std::sqrt(std::max(0., fSumW2[i]/N - T*T)/N);
+    G4double D  = T - transmission;
+    G4double sumD2 = fSumW2[i] - 2.*fSumW[i] + fTransmitted;
+    G4double errD = std::sqrt(std::max(0., sumD2/N - D*D)/N);
+
+    G4double areaDensity = thickness*density*fPerturbations[i].densityFactor;
+    G4double mu = 0., errMu = 0.;
+    if (T > 0.) {
+      mu = -std::log(T)/areaDensity;
+      errMu = errT/(T*areaDensity);
+    }
+    G4cout << "  " << fPerturbations[i].name << ": transmission " << T
+           << " +- " << errT << ", difference " << D << " +- " << errD
+           << ", mu/rho " << mu/(cm*cm/g) << " +- " << errMu/(cm*cm/g)
+           << " cm2/g" << G4endl;
+    output -> FillPerturbation(fPerturbations[i].name,
+                               density*fPerturbations[i].densityFactor/(g/cm3),
+                               T, errT, D, errD, mu/(cm*cm/g), errMu/(cm*cm/g));
+  }
+
+  G4double collided = 0.;
+  for (const auto& interaction : fInteractions) collided += interaction.second;
+  if (collided <= 0.) return;
+  G4cout << "  first interaction of the primaries in the slab:" << G4endl;
+  for (const auto& interaction : fInteractions)
+    G4cout << "    " << interaction.first << ": "
+           << 100.*interaction.second/collided << " %" << G4endl;
+}
@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/PerturbationMessenger.cc
+/// \brief Implementation of the PerturbationMessenger class
+//
+
+#include "PerturbationMessenger.hh"
+
+#include "PerturbationEstimator.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+PerturbationMessenger::PerturbationMessenger(PerturbationEstimator* estimator)
+:G4UImessenger(),fEstimator(estimator),fPerturbDir(nullptr),fDensityCmd(nullptr),
+ fCompositionCmd(nullptr),fClearCmd(nullptr)
+{ 
+  fPerturbDir = new G4UIdirectory("/testem/perturb/");
+  fPerturbDir->SetGuidance("perturbed slabs reweighted from the nominal run");
+
+  fDensityCmd = new G4UIcmdWithADouble("/testem/perturb/addDensity",this);
+  fDensityCmd->SetGuidance("Score the slab with its density times factor.");
+  fDensityCmd->SetParameterName("factor",false);
+  fDensityCmd->SetRange("factor>0.");
+  fDensityCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fCompositionCmd = new G4UIcommand("/testem/perturb/addComposition",this);
+  fCompositionCmd->SetGuidance("Change the mass fraction of element Z by delta");
+  fCompositionCmd->SetGuidance("in the perturbation of this name, at the same");
+  fCompositionCmd->SetGuidance("density; repeat the name for several elements.");
+  fCompositionCmd->SetGuidance("Fractions are renormalized to one.");
+  G4UIparameter* namePrm = new G4UIparameter("name",'s',false);
+  fCompositionCmd->SetParameter(namePrm);
+  G4UIparameter* zPrm = new G4UIparameter("Z",'i',false);
+  zPrm->SetParameterRange("Z>0 && Z<99");
+  fCompositionCmd->SetParameter(zPrm);
+  G4UIparameter* deltaPrm = new G4UIparameter("delta",'d',false);
+  deltaPrm->SetParameterRange("delta>-1. && delta<1.");
+  fCompositionCmd->SetParameter(deltaPrm);
+  fCompositionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testem/perturb/clear",this);
+  fClearCmd->SetGuidance("Remove all perturbations.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+PerturbationMessenger::~PerturbationMessenger()
+{
+  delete fDensityCmd;
+  delete fCompositionCmd;
+  delete fClearCmd;
+  delete fPerturbDir;
+}
+
+void PerturbationMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fDensityCmd )
+   { fEstimator->AddDensity(fDensityCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fCompositionCmd )
+   { G4String name;
+     G4int Z;
+     G4double delta;
+     std::istringstream is(newValue);
+     is >> name >> Z >> delta;
+     fEstimator->AddComposition(name, Z, delta);}
+
+  if( command == fClearCmd )
+   { fEstimator->Clear();}
+}
@@ -28,6 +28,7 @@
 
 #include "PhysicsList.hh"
 #include "PhysicsListMessenger.hh"
+#include "DetectorConstruction.hh"
  
 #include "G4EmStandardPhysics.hh"
 #include "G4EmStandardPhysics_option1.hh"
@@ -36,14 +37,41 @@
 #include "G4EmStandardPhysics_option4.hh"
 #include "G4EmLivermorePhysics.hh"
 #include "G4EmPenelopePhysics.hh"
+#include "G4FastSimulationPhysics.hh"
+
+#include "G4HadronElasticPhysics.hh"
+#include "G4HadronElasticPhysicsHP.hh"
+#include "G4HadronPhysicsQGSP_BIC.hh"
+#include "G4HadronPhysicsQGSP_BIC_HP.hh"
+#include "G4HadronPhysicsFTFP_BERT.hh"
+#include "G4HadronPhysicsFTFP_BERT_HP.hh"
+#include "G4IonPhysics.hh"
+#include "G4IonBinaryCascadePhysics.hh"
+#include "G4IonINCLXXPhysics.hh"
+#include "G4IonQMDPhysics.hh"
+
+#include "G4BosonConstructor.hh"
+#include "G4LeptonConstructor.hh"
+#include "G4MesonConstructor.hh"
+#include "G4BaryonConstructor.hh"
+#include "G4IonConstructor.hh"
+#include "G4ShortLivedConstructor.hh"
 
 #include "G4LossTableManager.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4StateManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
-PhysicsList::PhysicsList() 
+PhysicsList::PhysicsList(DetectorConstruction* det) 
 : G4VModularPhysicsList(),fCutForGamma(0),fCutForElectron(0),fCutForPositron(0),
-  fCurrentDefaultCut(0),fEmPhysicsList(nullptr),fEmName("default"),fMessenger(nullptr)
+  fCurrentDefaultCut(0),fKillGamma(0.),fKillElectron(0.),fKillPositron(0.),
+  fEmPhysicsList(nullptr),fEmName("default"),fHadronElastic(nullptr),
+  fHadronInelastic(nullptr),fIonInelastic(nullptr),fDetector(det),
+  fMessenger(nullptr)
 {    
   G4LossTableManager::Instance();
   
@@ -74,6 +102,26 @@ PhysicsList::~PhysicsList()
 void PhysicsList::ConstructParticle()
 {
  fEmPhysicsList -> ConstructParticle();
+
+ // hadronic models produce any hadron or nucleus
+ if (!HasHadronPhysics()) return;
+ G4BosonConstructor  pBosonConstructor;
+ pBosonConstructor.ConstructParticle();
+ G4LeptonConstructor pLeptonConstructor;
+ pLeptonConstructor.ConstructParticle();
+ G4MesonConstructor pMesonConstructor;
+ pMesonConstructor.ConstructParticle();
+ G4BaryonConstructor pBaryonConstructor;
+ pBaryonConstructor.ConstructParticle();
+ G4IonConstructor pIonConstructor;
+ pIonConstructor.ConstructParticle();
+ G4ShortLivedConstructor pShortLivedConstructor;
+ pShortLivedConstructor.ConstructParticle();
+}
+
+G4bool PhysicsList::HasHadronPhysics() const
+{
+  return fHadronElastic || fHadronInelastic || fIonInelastic;
 }
 
 //#include "G4EmProcessOptions.hh"
@@ -96,6 +144,17 @@ if (fEmName=="default")
  AddTransportation();
 
  fEmPhysicsList->ConstructProcess();
+
+ // hadronic physics
+ if (fHadronElastic)   fHadronElastic->ConstructProcess();
+ if (fHadronInelastic) fHadronInelastic->ConstructProcess();
+ if (fIonInelastic)    fIonInelastic->ConstructProcess();
+
+  // fast simulation of gammas in the slab region (SlabFastSimModel)
+  if (!fDetector || !fDetector->GetFastSimulation()) return;
+  G4FastSimulationPhysics fastSimulationPhysics;
+  fastSimulationPhysics.ActivateFastSimulation("gamma");
+  fastSimulationPhysics.ConstructProcess();
 }
 
 void PhysicsList::AddPhysicsList(const G4String& name)
@@ -141,6 +200,46 @@ void PhysicsList::AddPhysicsList(const G4String& name)
     delete fEmPhysicsList;
     fEmPhysicsList = new G4EmLivermorePhysics();
     
+  } else if (name == "elastic"){
+    delete fHadronElastic;
+    fHadronElastic = new G4HadronElasticPhysics();
+
+  } else if (name == "elastic_hp"){
+    delete fHadronElastic;
+    fHadronElastic = new G4HadronElasticPhysicsHP();
+
+  } else if (name == "binary"){
+    delete fHadronInelastic;
+    fHadronInelastic = new G4HadronPhysicsQGSP_BIC();
+
+  } else if (name == "binary_hp"){
+    delete fHadronInelastic;
+    fHadronInelastic = new G4HadronPhysicsQGSP_BIC_HP();
+
+  } else if (name == "bertini"){
+    delete fHadronInelastic;
+    fHadronInelastic = new G4HadronPhysicsFTFP_BERT();
+
+  } else if (name == "bertini_hp"){
+    delete fHadronInelastic;
+    fHadronInelastic = new G4HadronPhysicsFTFP_BERT_HP();
+
+  } else if (name == "ion"){
+    delete fIonInelastic;
+    fIonInelastic = new G4IonPhysics();
+
+  } else if (name == "ion_bic"){
+    delete fIonInelastic;
+    fIonInelastic = new G4IonBinaryCascadePhysics();
+
+  } else if (name == "ion_inclxx"){
+    delete fIonInelastic;
+    fIonInelastic = new G4IonINCLXXPhysics();
+
+  } else if (name == "ion_qmd"){
+    delete fIonInelastic;
+    fIonInelastic = new G4IonQMDPhysics();
+
   } else {
 
     G4cout << "PhysicsList::AddPhysicsList: <" << name << ">"
@@ -168,6 +267,7 @@ void PhysicsList::SetCuts()
   SetCutValue(fCutForGamma, "gamma");
   SetCutValue(fCutForElectron, "e-");
   SetCutValue(fCutForPositron, "e+");
+  ApplyRegionCuts();
   DumpCutValuesTable();
 }
 
@@ -175,6 +275,7 @@ void PhysicsList::SetCutForGamma(G4double cut)
 {
   fCutForGamma = cut;
   SetParticleCuts(fCutForGamma, G4Gamma::Gamma());
+  ApplyRegionCuts();
   DumpCutValuesTable();
 }
 
@@ -182,6 +283,7 @@ void PhysicsList::SetCutForElectron(G4double cut)
 {
   fCutForElectron = cut;
   SetParticleCuts(fCutForElectron, G4Electron::Electron());
+  ApplyRegionCuts();
   DumpCutValuesTable();
 }
 
@@ -189,6 +291,75 @@ void PhysicsList::SetCutForPositron(G4double cut)
 {
   fCutForPositron = cut;
   SetParticleCuts(fCutForPositron, G4Positron::Positron());
+  ApplyRegionCuts();
   DumpCutValuesTable();
 }
 
+void PhysicsList::SetRegionCut(const G4String& region, const G4String& particle,
+                               G4double cut)
+{
+  // the world region has a Geant4 name
+  G4String name = (region == "World") ? "DefaultRegionForTheWorld" : region;
+  std::vector<G4double>& cuts = fRegionCuts[name];
+  if (cuts.empty()) cuts.assign(3, -1.);
+
+  if      (particle == "gamma") cuts[0] = cut;
+  else if (particle == "e-")    cuts[1] = cut;
+  else if (particle == "e+")    cuts[2] = cut;
+  else if (particle == "all")   cuts.assign(3, cut);
+  else {
+    G4cout << "\n--> warning from PhysicsList::SetRegionCut : no cut for "
+           << particle << G4endl;
+    return;
+  }
+  ApplyRegionCuts();
+  DumpCutValuesTable();
+}
+
+void PhysicsList::ApplyRegionCuts()
+{
+  // the regions exist once the geometry is built; SetCuts applies them then
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_PreInit)
+    return;
+
+  G4ProductionCuts* defaultCuts =
+    G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+  const G4double global[3] = {fCutForGamma, fCutForElectron, fCutForPositron};
+  const char* particles[3] = {"gamma", "e-", "e+"};
+
+  for (auto& regionCuts : fRegionCuts) {
+    G4Region* region =
+      G4RegionStore::GetInstance()->GetRegion(regionCuts.first, false);
+    if (!region) {
+      G4cout << "\n--> warning from PhysicsList::ApplyRegionCuts : no region "
+             << regionCuts.first << G4endl;
+      continue;
+    }
+    // a region with cuts of its own no longer follows the global ones
+    G4ProductionCuts* cuts = region->GetProductionCuts();
+    if (!cuts || cuts == defaultCuts) {
+      cuts = new G4ProductionCuts(*defaultCuts);
+      region->SetProductionCuts(cuts);
+    }
+    for (G4int i = 0; i < 3; ++i) {
+      G4double cut = regionCuts.second[i];
+      cuts->SetProductionCut(cut >= 0. ? cut : global[i], particles[i]);
+    }
+  }
+}
+
+void PhysicsList::SetKillThreshold(const G4String& particle, G4double energy)
+{
+  if      (particle == "gamma") fKillGamma = energy;
+  else if (particle == "e-")    fKillElectron = energy;
+  else if (particle == "e+")    fKillPositron = energy;
+  else if (particle == "all")   fKillGamma = fKillElectron = fKillPositron = energy;
+  else {
+    G4cout << "\n--> warning from PhysicsList::SetKillThreshold : no threshold for "
+           << particle << G4endl;
+    return;
+  }
+  G4cout << " Secondary " << particle << " killed below "
+         << G4BestUnit(energy,"Energy") << G4endl;
+}
+
@@ -37,13 +37,17 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithAString.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PhysicsListMessenger::PhysicsListMessenger(PhysicsList* pPhys)
 :G4UImessenger(),
  fPhysicsList(pPhys),fPhysDir(0),fGammaCutCmd(0),fElectCutCmd(0),
- fProtoCutCmd(0),fAllCutCmd(0),fListCmd(0)
+ fProtoCutCmd(0),fAllCutCmd(0),fListCmd(0),fRegionCutCmd(0),fKillCmd(0)
 { 
   fPhysDir = new G4UIdirectory("/testem/phys/");
   fPhysDir->SetGuidance("physics list commands");
@@ -54,6 +58,7 @@ PhysicsListMessenger::PhysicsListMessenger(PhysicsList* pPhys)
   fGammaCutCmd->SetUnitCategory("Length");
   fGammaCutCmd->SetRange("Gcut>0.0");
   fGammaCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fGammaCutCmd->SetToBeBroadcasted(false);
 
   fElectCutCmd = new G4UIcmdWithADoubleAndUnit("/testem/phys/setECut",this);  
   fElectCutCmd->SetGuidance("Set electron cut.");
@@ -61,13 +66,15 @@ PhysicsListMessenger::PhysicsListMessenger(PhysicsList* pPhys)
   fElectCutCmd->SetUnitCategory("Length");
   fElectCutCmd->SetRange("Ecut>0.0");
   fElectCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fElectCutCmd->SetToBeBroadcasted(false);
   
   fProtoCutCmd = new G4UIcmdWithADoubleAndUnit("/testem/phys/setPCut",this);  
   fProtoCutCmd->SetGuidance("Set positron cut.");
   fProtoCutCmd->SetParameterName("Pcut",false);
   fProtoCutCmd->SetUnitCategory("Length");
   fProtoCutCmd->SetRange("Pcut>0.0");
-  fProtoCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);  
+  fProtoCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fProtoCutCmd->SetToBeBroadcasted(false);
 
   fAllCutCmd = new G4UIcmdWithADoubleAndUnit("/testem/phys/setCuts",this);  
   fAllCutCmd->SetGuidance("Set cut for all.");
@@ -75,11 +82,49 @@ PhysicsListMessenger::PhysicsListMessenger(PhysicsList* pPhys)
   fAllCutCmd->SetUnitCategory("Length");
   fAllCutCmd->SetRange("cut>0.0");
   fAllCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAllCutCmd->SetToBeBroadcasted(false);
 
   fListCmd = new G4UIcmdWithAString("/testem/phys/addPhysics",this);  
   fListCmd->SetGuidance("Add modula physics list.");
+  fListCmd->SetGuidance("EM: emstandard_opt0..4, emlivermore, empenelope;");
+  fListCmd->SetGuidance("hadronic, added to the EM list: elastic, elastic_hp,");
+  fListCmd->SetGuidance("binary, binary_hp, bertini, bertini_hp, ion, ion_bic,");
+  fListCmd->SetGuidance("ion_inclxx, ion_qmd.");
   fListCmd->SetParameterName("PList",false);
-  fListCmd->AvailableForStates(G4State_PreInit);  
+  fListCmd->AvailableForStates(G4State_PreInit);
+  fListCmd->SetToBeBroadcasted(false);
+
+  fRegionCutCmd = new G4UIcommand("/testem/phys/setRegionCut",this);
+  fRegionCutCmd->SetGuidance("Set cut of one region (Target or World);");
+  fRegionCutCmd->SetGuidance("the other region keeps the global cuts.");
+  G4UIparameter* regionPrm = new G4UIparameter("region",'s',false);
+  fRegionCutCmd->SetParameter(regionPrm);
+  G4UIparameter* partPrm = new G4UIparameter("particle",'s',false);
+  partPrm->SetParameterCandidates("gamma e- e+ all");
+  fRegionCutCmd->SetParameter(partPrm);
+  G4UIparameter* cutPrm = new G4UIparameter("cut",'d',false);
+  cutPrm->SetParameterRange("cut>0.");
+  fRegionCutCmd->SetParameter(cutPrm);
+  G4UIparameter* lenUnitPrm = new G4UIparameter("unit",'s',true);
+  lenUnitPrm->SetDefaultUnit("mm");
+  fRegionCutCmd->SetParameter(lenUnitPrm);
+  fRegionCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fRegionCutCmd->SetToBeBroadcasted(false);
+
+  fKillCmd = new G4UIcommand("/testem/phys/setKillThreshold",this);
+  fKillCmd->SetGuidance("Kill secondaries below this kinetic energy.");
+  fKillCmd->SetGuidance("Only the exit-face scorer can see the difference.");
+  G4UIparameter* killPartPrm = new G4UIparameter("particle",'s',false);
+  killPartPrm->SetParameterCandidates("gamma e- e+ all");
+  fKillCmd->SetParameter(killPartPrm);
+  G4UIparameter* energyPrm = new G4UIparameter("energy",'d',false);
+  energyPrm->SetParameterRange("energy>=0.");
+  fKillCmd->SetParameter(energyPrm);
+  G4UIparameter* eneUnitPrm = new G4UIparameter("unit",'s',true);
+  eneUnitPrm->SetDefaultUnit("keV");
+  fKillCmd->SetParameter(eneUnitPrm);
+  fKillCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fKillCmd->SetToBeBroadcasted(false);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -91,6 +136,8 @@ PhysicsListMessenger::~PhysicsListMessenger()
   delete fProtoCutCmd;
   delete fAllCutCmd;
   delete fListCmd;
+  delete fRegionCutCmd;
+  delete fKillCmd;
   delete fPhysDir;
 }
 
@@ -118,6 +165,22 @@ void PhysicsListMessenger::SetNewValue(G4UIcommand* command,
     
   if( command == fListCmd )
    { fPhysicsList->AddPhysicsList(newValue);}
+
+  if( command == fRegionCutCmd )
+   { G4String region, particle, unit;
+     G4double cut;
+     std::istringstream is(newValue);
+     is >> region >> particle >> cut >> unit;
+     fPhysicsList->SetRegionCut(region, particle,
+                                cut*G4UIcommand::ValueOf(unit));}
+
+  if( command == fKillCmd )
+   { G4String particle, unit;
+     G4double energy;
+     std::istringstream is(newValue);
+     is >> particle >> energy >> unit;
+     fPhysicsList->SetKillThreshold(particle,
+                                    energy*G4UIcommand::ValueOf(unit));}
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,268 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/PointScheduler.cc
+/// \brief Implementation of the PointScheduler class
+//
+
+#include "PointScheduler.hh"
+#include "PointSchedulerMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "Checkpoint.hh"
+#include "ProgressMonitor.hh"
+#include "EventWatchdog.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct PointScheduler::Slot
+{
+  std::atomic<G4int> done;
+  G4double transmitted;
+  G4double events;
+  G4double areaDensity;
+  G4double seconds;
+};
+
+struct PointScheduler::Shared
+{
+  std::atomic<G4int> next;
+  G4int nPoints;
+  Slot  slots[1];
+};
+
+PointScheduler::PointScheduler(DetectorConstruction* det,
+                               PrimaryGeneratorAction* prim)
+:fDetector(det),fPrimary(prim),fMessenger(nullptr),fEventsPerPoint(100000),
+ fNumberOfWorkers(0),fSeed(12345)
+{
+  fMessenger = new PointSchedulerMessenger(this);
+}
+
+PointScheduler::~PointScheduler()
+{
+  delete fMessenger;
+}
+
+void PointScheduler::SetSeed(G4long val)
+{
+  if (val <= 0) {
+    G4cout << "\n--> warning from PointScheduler::SetSeed : " << val
+           << " is not positive, command refused" << G4endl;
+    return;
+  }
+  fSeed = val;
+}
+
+void PointScheduler::AddPoint(const G4String& material, G4double energy,
+                              G4double thickness)
+{
+  Point point;
+  point.material = material;
+  point.energy = energy;
+  point.thickness = thickness;
+  fPoints.push_back(point);
+}
+
+void PointScheduler::Run()
+{
+  if (fPoints.empty()) {
+    G4cout << "\n--> warning from PointScheduler::Run : no point" << G4endl;
+    return;
+  }
+  // a process with worker threads cannot be forked safely
+  if (G4Threading::IsMultithreadedApplication()) {
+    G4cout << "\n--> warning from PointScheduler::Run : needs the sequential "
+           << "run manager (no -t), points not run" << G4endl;
+    return;
+  }
+
+  // physics tables built once, shared copy-on-write by the workers
+  G4RunManager::GetRunManager()->BeamOn(0);
+
+  G4int nPoints = fPoints.size();
+  std::size_t bytes = sizeof(Shared) + (nPoints - 1)*sizeof(Slot);
+  void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    G4cout << "\n--> warning from PointScheduler::Run : no shared memory"
+           << G4endl;
+    return;
+  }
+  Shared* shared = new (memory) Shared;
+  shared->next = 0;
+  shared->nPoints = nPoints;
+  for (G4int i = 0; i < nPoints; ++i) new (&shared->slots[i]) Slot{};
+
+  G4int nWorkers = fNumberOfWorkers;
+  if (nWorkers <= 0) nWorkers = sysconf(_SC_NPROCESSORS_ONLN);
+  nWorkers = std::max(1, std::min(nWorkers, nPoints));
+
+  G4cout << "\n PointScheduler: " << nPoints << " points on " << nWorkers
+         << " worker processes" << G4endl;
+
+  // nothing buffered may be written twice by the children
+  WriteOutputFile::GetInstance()->Flush();
+  std::cout.flush();
+
+  std::vector<pid_t> workers;
+  for (G4int w = 0; w < nWorkers; ++w) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      RunWorker(shared, w);
+      // _exit skips the stream destructors
+      G4cout << std::flush;
+      WriteOutputFile::GetInstance()->Flush();
+      std::cout.flush();
+      std::fflush(nullptr);
+      _exit(0);
+    }
+    if (pid > 0) workers.push_back(pid);
+    else G4cout << "\n--> warning from PointScheduler::Run : fork failed"
+                << G4endl;
+  }
+
+  // results in list order, each as soon as the points before it are done
+  G4int written = 0;
+  G4int running = workers.size();
+  while (written < nPoints) {
+    while (written < nPoints &&
+           shared->slots[written].done.load(std::memory_order_acquire)) {
+      Write(written, shared->slots[written]);
+      ++written;
+    }
+    if (written == nPoints || running == 0) break;
+    // a worker that died leaves its point undone
+    int status = 0;
+    if (waitpid(-1, &status, WNOHANG) > 0) --running;
+    else usleep(10000);
+  }
+  for (pid_t pid : workers) waitpid(pid, nullptr, 0);
+
+  // past a point left undone, the points done after it
+  std::vector<G4int> missing;
+  for (G4int index = written; index < nPoints; ++index) {
+    if (shared->slots[index].done.load(std::memory_order_acquire))
+      Write(index, shared->slots[index]);
+    else missing.push_back(index);
+  }
+  if (!missing.empty()) {
+    G4cout << "\n--> warning from PointScheduler::Run : workers ended with "
+           << missing.size() << " points not done:";
+    for (G4int index : missing) G4cout << " " << index;
+    G4cout << G4endl;
+  }
+  WriteOutputFile::GetInstance()->Flush();
+
+  munmap(memory, bytes);
+}
+
+void PointScheduler::RunWorker(Shared* shared, G4int worker)
+{
+  // the parent writes the results; per-run output of a worker would collide
+  WriteOutputFile::GetInstance()->SetSuppressed(true);
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  // the files of the job are the parent's: no checkpoint in a worker, which
+  // the scheduler could not resume, and per-worker progress and slow events
+  RunAction* runAction = const_cast<RunAction*>(
+    static_cast<const RunAction*>(runManager->GetUserRunAction()));
+  Checkpoint* checkpoint = runAction->GetCheckpoint();
+  checkpoint->SetEveryEvents(0);
+  checkpoint->SetEverySeconds(0.);
+  checkpoint->SetResume(false);
+  G4String suffix = "_worker" + std::to_string(worker);
+  ProgressMonitor* progress = runAction->GetProgressMonitor();
+  progress->SetFileName(progress->GetFileName() + suffix);
+  EventWatchdog* watchdog = runAction->GetWatchdog();
+  watchdog->SetFileName(watchdog->GetFileName() + suffix);
+
+  G4ParticleGun* gun = fPrimary->GetParticleGun();
+  G4int index;
+  while ((index = shared->next.fetch_add(1)) < shared->nPoints) {
+    const Point& point = fPoints[index];
+    fDetector->SetMaterial(point.material);
+    fDetector->SetThickness(point.thickness);
+    runManager->PhysicsHasBeenModified();
+    runManager->GeometryHasBeenModified();
+    gun->SetParticleEnergy(point.energy);
+
+    // the stream of a point depends on its index only
+    long seeds[3] = {fSeed, index + 1, 0};
+    G4Random::setTheSeeds(seeds);
+
+    auto start = std::chrono::steady_clock::now();
+    runManager->BeamOn(fEventsPerPoint);
+    auto stop = std::chrono::steady_clock::now();
+
+    const RunAction* run =
+      static_cast<const RunAction*>(runManager->GetUserRunAction());
+    Slot& slot = shared->slots[index];
+    slot.transmitted = run->GetTransmitted();
+    slot.events = run->GetNumberOfEvents();
+    slot.areaDensity = fDetector->GetSize()*fDetector->GetDensity();
+    slot.seconds = std::chrono::duration<G4double>(stop - start).count();
+    slot.done.store(1, std::memory_order_release);
+  }
+}
+
+void PointScheduler::Write(G4int index, const Slot& slot)
+{
+  const Point& point = fPoints[index];
+  G4double mu = 0., error = 0.;
+  G4double transmission = (slot.events > 0.) ? slot.transmitted/slot.events : 0.;
+  if (transmission > 0. && transmission < 1.) {
+    mu = -std::log(transmission)/slot.areaDensity;
+    error = std::sqrt((1.-transmission)/(slot.events*transmission))
+            /slot.areaDensity;
+  }
+
+  G4cout << " point " << index << ": " << point.material << " "
+         << G4BestUnit(point.energy,"Energy") << " "
+         << G4BestUnit(point.thickness,"Length") << " mu/rho = "
+         << mu/(cm2/g) << " +- " << error/(cm2/g) << " cm2/g ("
+         << slot.seconds << " s)" << G4endl;
+  WriteOutputFile::GetInstance()->FillPoint(point.material, point.energy/MeV,
+                    point.thickness/mm, slot.events, slot.transmitted,
+                    mu/(cm2/g), error/(cm2/g));
+}
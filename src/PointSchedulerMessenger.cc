@@ -0,0 +1,133 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/PointSchedulerMessenger.cc
+/// \brief Implementation of the PointSchedulerMessenger class
+//
+
+#include "PointSchedulerMessenger.hh"
+
+#include "PointScheduler.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+PointSchedulerMessenger::PointSchedulerMessenger(PointScheduler* scheduler)
+:G4UImessenger(),fScheduler(scheduler),fPointsDir(nullptr),fAddCmd(nullptr),
+ fClearCmd(nullptr),fEventsCmd(nullptr),fWorkersCmd(nullptr),fSeedCmd(nullptr),
+ fRunCmd(nullptr)
+{ 
+  fPointsDir = new G4UIdirectory("/testem/points/");
+  fPointsDir->SetGuidance("independent points run by a pool of processes");
+
+  fAddCmd = new G4UIcommand("/testem/points/add",this);
+  fAddCmd->SetGuidance("Add a point: material, energy and slab thickness.");
+  fAddCmd->SetParameter(new G4UIparameter("material",'s',false));
+  G4UIparameter* energyPrm = new G4UIparameter("energy",'d',false);
+  energyPrm->SetParameterRange("energy>0.");
+  fAddCmd->SetParameter(energyPrm);
+  G4UIparameter* eneUnitPrm = new G4UIparameter("eunit",'s',false);
+  eneUnitPrm->SetDefaultUnit("MeV");
+  fAddCmd->SetParameter(eneUnitPrm);
+  G4UIparameter* thickPrm = new G4UIparameter("thickness",'d',false);
+  thickPrm->SetParameterRange("thickness>0.");
+  fAddCmd->SetParameter(thickPrm);
+  G4UIparameter* lenUnitPrm = new G4UIparameter("lunit",'s',false);
+  lenUnitPrm->SetDefaultUnit("mm");
+  fAddCmd->SetParameter(lenUnitPrm);
+  fAddCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAddCmd->SetToBeBroadcasted(false);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testem/points/clear",this);
+  fClearCmd->SetGuidance("Remove all points.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearCmd->SetToBeBroadcasted(false);
+
+  fEventsCmd = new G4UIcmdWithAnInteger("/testem/points/setEvents",this);
+  fEventsCmd->SetGuidance("Set number of events per point.");
+  fEventsCmd->SetParameterName("nevt",false);
+  fEventsCmd->SetRange("nevt>0");
+  fEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEventsCmd->SetToBeBroadcasted(false);
+
+  fWorkersCmd = new G4UIcmdWithAnInteger("/testem/points/setWorkers",this);
+  fWorkersCmd->SetGuidance("Set number of worker processes (0: one per cpu).");
+  fWorkersCmd->SetParameterName("n",false);
+  fWorkersCmd->SetRange("n>=0");
+  fWorkersCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fWorkersCmd->SetToBeBroadcasted(false);
+
+  fSeedCmd = new G4UIcmdWithAnInteger("/testem/points/setSeed",this);
+  fSeedCmd->SetGuidance("Set seed from which the point streams are derived.");
+  fSeedCmd->SetParameterName("seed",false);
+  fSeedCmd->SetRange("seed>0");
+  fSeedCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fSeedCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithoutParameter("/testem/points/run",this);
+  fRunCmd->SetGuidance("Run all points and write them in list order.");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+}
+
+PointSchedulerMessenger::~PointSchedulerMessenger()
+{
+  delete fAddCmd;
+  delete fClearCmd;
+  delete fEventsCmd;
+  delete fWorkersCmd;
+  delete fSeedCmd;
+  delete fRunCmd;
+  delete fPointsDir;
+}
+
+void PointSchedulerMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fAddCmd )
+   { G4String material, energyUnit, lengthUnit;
+     G4double energy, thickness;
+     std::istringstream is(newValue);
+     is >> material >> energy >> energyUnit >> thickness >> lengthUnit;
+     fScheduler->AddPoint(material, energy*G4UIcommand::ValueOf(energyUnit),
+                          thickness*G4UIcommand::ValueOf(lengthUnit));}
+
+  if( command == fClearCmd )
+   { fScheduler->ClearPoints();}
+
+  if( command == fEventsCmd )
+   { fScheduler->SetEventsPerPoint(fEventsCmd->GetNewIntValue(newValue));}
+
+  if( command == fWorkersCmd )
+   { fScheduler->SetNumberOfWorkers(fWorkersCmd->GetNewIntValue(newValue));}
+
+  if( command == fSeedCmd )
+   { fScheduler->SetSeed(fSeedCmd->GetNewIntValue(newValue));}
+
+  if( command == fRunCmd )
+   { fScheduler->Run();}
+}
@@ -35,24 +35,39 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "SpectrumSampler.hh"
 
 #include "DetectorConstruction.hh"
+#include "CTPhantom.hh"
 
 #include "G4Event.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "Randomize.hh"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 
-PrimaryGeneratorAction::PrimaryGeneratorAction()
-:G4VUserPrimaryGeneratorAction(),fParticleGun(nullptr)                                      
+
+PrimaryGeneratorAction::PrimaryGeneratorAction(DetectorConstruction* det)
+:G4VUserPrimaryGeneratorAction(),fParticleGun(nullptr),fMessenger(nullptr),
+ fDetector(det),fSpectrum(nullptr),fUseSpectrum(false),fCurrentBin(0),
+ fUseRaster(false),fRasterNy(1),fRasterNz(1),fRasterPitch(1.*mm),
+ fCurrentRay(0),fEventOffset(0)
 {
   fParticleGun  = new G4ParticleGun(1);
   SetDefaultKinematic();
+  fMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+  delete fMessenger;
+  delete fSpectrum;
   delete fParticleGun;
 }
 
@@ -71,9 +86,136 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   //this function is called at the begining of event
   //
+  if (fUseSpectrum) {
+    G4double u1 = G4UniformRand();
+    G4double u2 = G4UniformRand();
+    fCurrentBin = fSpectrum->SampleBin(u1, u2);
+    fSampledPerBin[fCurrentBin] += 1;
+    fParticleGun->SetParticleEnergy(fSpectrum->GetEnergy(fCurrentBin));
+  }
+
+  CTPhantom* phantom = fDetector->GetPhantom();
+  if (fUseRaster) {
+    // deterministic sweep: every pixel gets the same number of events
+    fCurrentRay =
+      (anEvent->GetEventID() + fEventOffset) % (fRasterNy*fRasterNz);
+    G4double y = (fCurrentRay%fRasterNy + 0.5 - 0.5*fRasterNy)*fRasterPitch;
+    G4double z = (fCurrentRay/fRasterNy + 0.5 - 0.5*fRasterNz)*fRasterPitch;
+    if (fCurrentRay < (G4int)fSampledPerRay.size())
+      fSampledPerRay[fCurrentRay] += 1;
+    G4double x = fParticleGun->GetParticlePosition().x();
+    fParticleGun->SetParticlePosition(G4ThreeVector(x,y,z));
+  }
+  else if (phantom->IsActive()) {
+    G4int ny = phantom->GetNy();
+    G4int nz = phantom->GetNz();
+    G4int iy = std::min((G4int)(G4UniformRand()*ny), ny-1);
+    G4int iz = std::min((G4int)(G4UniformRand()*nz), nz-1);
+    G4double y = (iy + G4UniformRand() - 0.5*ny)*phantom->GetVoxelY();
+    G4double z = (iz + G4UniformRand() - 0.5*nz)*phantom->GetVoxelZ();
+    fCurrentRay = iy + ny*iz;
+    if (fCurrentRay < (G4int)fSampledPerRay.size())
+      fSampledPerRay[fCurrentRay] += 1;
+    G4double x = fParticleGun->GetParticlePosition().x();
+    fParticleGun->SetParticlePosition(G4ThreeVector(x,y,z));
+  }
+  else if (fDetector->GetNumberOfLanes() > 0) {
+    G4int nLanes = fDetector->GetNumberOfLanes();
+    fCurrentRay = (anEvent->GetEventID() + fEventOffset) % nLanes;
+    G4double y = (fCurrentRay + 0.5 - 0.5*nLanes)*fDetector->GetLaneWidth();
+    if (fCurrentRay < (G4int)fSampledPerRay.size())
+      fSampledPerRay[fCurrentRay] += 1;
+    const G4ThreeVector& position = fParticleGun->GetParticlePosition();
+    fParticleGun->SetParticlePosition(G4ThreeVector(position.x(),y,position.z()));
+  }
   fParticleGun->GeneratePrimaryVertex(anEvent); 
 }
 
+void PrimaryGeneratorAction::LoadSpectrum(const G4String& fileName)
+{
+  SpectrumSampler* spectrum = new SpectrumSampler();
+  if (!spectrum->Load(fileName)) {
+    delete spectrum;
+    return;
+  }
+  delete fSpectrum;
+  fSpectrum = spectrum;
+  fSampledPerBin.assign(fSpectrum->GetNumberOfBins(), 0.);
+  SetUseSpectrum(true);
+}
+
+void PrimaryGeneratorAction::SetUseSpectrum(G4bool val)
+{
+  if (val && !fSpectrum) {
+    G4cout << "\n--> warning from PrimaryGeneratorAction::SetUseSpectrum : "
+           << "no spectrum loaded, staying mono-energetic" << G4endl;
+    return;
+  }
+  fUseSpectrum = val;
+}
+
+void PrimaryGeneratorAction::SetRasterPixels(G4int ny, G4int nz)
+{
+  if (ny < 1 || nz < 1) {
+    G4cout << "\n--> warning from PrimaryGeneratorAction::SetRasterPixels : "
+           << ny << " x " << nz << " pixels, command refused" << G4endl;
+    return;
+  }
+  fRasterNy = ny;
+  fRasterNz = nz;
+}
+
+G4bool PrimaryGeneratorAction::UseLanes()
+{
+  return !fUseRaster && !fDetector->GetPhantom()->IsActive()
+         && fDetector->GetNumberOfLanes() > 0;
+}
+
+G4int PrimaryGeneratorAction::GetRayGridNy()
+{
+  if (fUseRaster) return fRasterNy;
+  CTPhantom* phantom = fDetector->GetPhantom();
+  if (phantom->IsActive()) return phantom->GetNy();
+  return fDetector->GetNumberOfLanes();
+}
+
+G4int PrimaryGeneratorAction::GetRayGridNz()
+{
+  if (fUseRaster) return fRasterNz;
+  CTPhantom* phantom = fDetector->GetPhantom();
+  if (phantom->IsActive()) return phantom->GetNz();
+  return fDetector->GetNumberOfLanes() > 0 ? 1 : 0;
+}
+
+void PrimaryGeneratorAction::ResetSampledPerRay(G4int nRays)
+{
+  fSampledPerRay.assign(nRays, 0.);
+  fEventOffset = 0;
+}
+
+void PrimaryGeneratorAction::RestoreSampled(const std::vector<G4double>& perBin,
+                                            const std::vector<G4double>& perRay,
+                                            G4int eventOffset)
+{
+  if (!perBin.empty()) fSampledPerBin = perBin;
+  if (!perRay.empty()) fSampledPerRay = perRay;
+  fEventOffset = eventOffset;
+}
+
+void PrimaryGeneratorAction::ResetSampledPerBin()
+{
+  std::fill(fSampledPerBin.begin(), fSampledPerBin.end(), 0.);
+}
+
+void PrimaryGeneratorAction::SetEnergyOfAllGuns(G4double energy)
+{
+  // a UI command is broadcast to the workers; full precision, the energy
+  // may sit next to an absorption edge
+  std::ostringstream command;
+  command << std::setprecision(17) << "/gun/energy " << energy/MeV << " MeV";
+  G4UImanager::GetUIpointer()->ApplyCommand(command.str());
+}
+
 G4double PrimaryGeneratorAction::GetInitialEnergy()
 {
   G4double primaryParticleEnergy = fParticleGun->GetParticleEnergy(); 
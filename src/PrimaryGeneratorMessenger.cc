@@ -0,0 +1,115 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the PrimaryGeneratorMessenger class
+//
+
+#include "PrimaryGeneratorMessenger.hh"
+
+#include "PrimaryGeneratorAction.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include <sstream>
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* prim)
+:G4UImessenger(),fPrimary(prim),fGunDir(nullptr),fSpectrumCmd(nullptr),
+ fUseSpectrumCmd(nullptr),fRasterCmd(nullptr),fRasterPixelsCmd(nullptr),
+ fRasterPitchCmd(nullptr)
+{ 
+  fGunDir = new G4UIdirectory("/testem/gun/");
+  fGunDir->SetGuidance("primary generator commands");
+
+  fSpectrumCmd = new G4UIcmdWithAString("/testem/gun/spectrumFile",this);
+  fSpectrumCmd->SetGuidance("Load a tabulated spectrum and use it as source.");
+  fSpectrumCmd->SetGuidance("One 'energy(MeV) weight' pair per line.");
+  fSpectrumCmd->SetParameterName("file",false);
+  fSpectrumCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fUseSpectrumCmd = new G4UIcmdWithABool("/testem/gun/useSpectrum",this);
+  fUseSpectrumCmd->SetGuidance("Switch between the loaded spectrum and /gun/energy.");
+  fUseSpectrumCmd->SetParameterName("use",true);
+  fUseSpectrumCmd->SetDefaultValue(true);
+  fUseSpectrumCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRasterCmd = new G4UIcmdWithABool("/testem/gun/raster",this);
+  fRasterCmd->SetGuidance("Sweep pencil beams over a (y,z) pixel grid,");
+  fRasterCmd->SetGuidance("event n in pixel n%(ny*nz); image in Radiography.raw");
+  fRasterCmd->SetParameterName("raster",true);
+  fRasterCmd->SetDefaultValue(true);
+  fRasterCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRasterPixelsCmd = new G4UIcommand("/testem/gun/rasterPixels",this);
+  fRasterPixelsCmd->SetGuidance("Number of raster pixels along y and z.");
+  G4UIparameter* nyPrm = new G4UIparameter("ny",'i',false);
+  nyPrm->SetParameterRange("ny>0");
+  fRasterPixelsCmd->SetParameter(nyPrm);
+  G4UIparameter* nzPrm = new G4UIparameter("nz",'i',false);
+  nzPrm->SetParameterRange("nz>0");
+  fRasterPixelsCmd->SetParameter(nzPrm);
+  fRasterPixelsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRasterPitchCmd = new G4UIcmdWithADoubleAndUnit("/testem/gun/rasterPitch",this);
+  fRasterPitchCmd->SetGuidance("Pixel pitch of the raster.");
+  fRasterPitchCmd->SetParameterName("pitch",false);
+  fRasterPitchCmd->SetRange("pitch>0.");
+  fRasterPitchCmd->SetUnitCategory("Length");
+  fRasterPitchCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete fSpectrumCmd;
+  delete fUseSpectrumCmd;
+  delete fRasterCmd;
+  delete fRasterPixelsCmd;
+  delete fRasterPitchCmd;
+  delete fGunDir;
+}
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fSpectrumCmd )
+   { fPrimary->LoadSpectrum(newValue);}
+
+  if( command == fUseSpectrumCmd )
+   { fPrimary->SetUseSpectrum(fUseSpectrumCmd->GetNewBoolValue(newValue));}
+
+  if( command == fRasterCmd )
+   { fPrimary->SetRaster(fRasterCmd->GetNewBoolValue(newValue));}
+
+  if( command == fRasterPixelsCmd )
+   { G4int ny, nz;
+     std::istringstream is(newValue);
+     is >> ny >> nz;
+     fPrimary->SetRasterPixels(ny, nz);
+   }
+
+  if( command == fRasterPitchCmd )
+   { fPrimary->SetRasterPitch(fRasterPitchCmd->GetNewDoubleValue(newValue));}
+}
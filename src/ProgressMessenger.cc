@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ProgressMessenger.cc
+/// \brief Implementation of the ProgressMessenger class
+//
+
+#include "ProgressMessenger.hh"
+
+#include "ProgressMonitor.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4SystemOfUnits.hh"
+
+ProgressMessenger::ProgressMessenger(ProgressMonitor* monitor)
+:G4UImessenger(),fMonitor(monitor),fProgressDir(nullptr),fActivateCmd(nullptr),
+ fIntervalCmd(nullptr),fFileCmd(nullptr)
+{ 
+  fProgressDir = new G4UIdirectory("/testem/progress/");
+  fProgressDir->SetGuidance("progress and throughput of long runs");
+
+  fActivateCmd = new G4UIcmdWithABool("/testem/progress/activate",this);
+  fActivateCmd->SetGuidance("Report progress during runs.");
+  fActivateCmd->SetParameterName("flag",true);
+  fActivateCmd->SetDefaultValue(true);
+  fActivateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fIntervalCmd = new G4UIcmdWithADoubleAndUnit("/testem/progress/setInterval",this);
+  fIntervalCmd->SetGuidance("Set wall time between two progress reports.");
+  fIntervalCmd->SetParameterName("T",false);
+  fIntervalCmd->SetRange("T>0.");
+  fIntervalCmd->SetUnitCategory("Time");
+  fIntervalCmd->SetDefaultUnit("s");
+  fIntervalCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/progress/setFileName",this);
+  fFileCmd->SetGuidance("Set name of the status file.");
+  fFileCmd->SetParameterName("file",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+ProgressMessenger::~ProgressMessenger()
+{
+  delete fActivateCmd;
+  delete fIntervalCmd;
+  delete fFileCmd;
+  delete fProgressDir;
+}
+
+void ProgressMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fActivateCmd )
+   { fMonitor->SetActive(fActivateCmd->GetNewBoolValue(newValue));}
+
+  if( command == fIntervalCmd )
+   { fMonitor->SetInterval(fIntervalCmd->GetNewDoubleValue(newValue)/s);}
+
+  if( command == fFileCmd )
+   { fMonitor->SetFileName(newValue);}
+}
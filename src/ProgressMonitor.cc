@@ -0,0 +1,159 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ProgressMonitor.cc
+/// \brief Implementation of the ProgressMonitor class
+//
+
+#include "ProgressMonitor.hh"
+#include "ProgressMessenger.hh"
+#include "RunAction.hh"
+#include "DetectorConstruction.hh"
+#include "CTPhantom.hh"
+
+#include "G4Run.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+std::atomic<G4long> ProgressMonitor::fEventsRequested(0);
+std::atomic<G4long> ProgressMonitor::fEventsDone(0);
+std::atomic<G4long> ProgressMonitor::fEventsAtStart(0);
+std::atomic<G4long> ProgressMonitor::fTransmitted(0);
+std::atomic<std::chrono::steady_clock::rep> ProgressMonitor::fStart(0);
+std::atomic<std::chrono::steady_clock::rep> ProgressMonitor::fNextReport(0);
+
+namespace {
+
+std::chrono::steady_clock::rep Ticks(G4double seconds)
+{
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+           std::chrono::duration<G4double>(seconds)).count();
+}
+
+std::chrono::steady_clock::rep Now()
+{
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}
+
+ProgressMonitor::ProgressMonitor(RunAction* run, DetectorConstruction* det)
+:fRunAction(run),fDetector(det),fMessenger(nullptr),fActive(false),
+ fInterval(60.),fFileName("progress.status"),fRunID(0),fTransmittedAdded(0)
+{
+  fMessenger = new ProgressMessenger(this);
+}
+
+ProgressMonitor::~ProgressMonitor()
+{
+  delete fMessenger;
+}
+
+void ProgressMonitor::BeginOfRun(const G4Run* run, G4int eventsDone)
+{
+  fRunID = run->GetRunID();
+  fTransmittedAdded = (G4long)fRunAction->GetTransmitted();
+
+  // the master starts the run before the workers
+  if (!G4Threading::IsMasterThread()) return;
+  fEventsRequested = run->GetNumberOfEventToBeProcessed();
+  fEventsDone = fEventsAtStart = eventsDone;
+  fTransmitted = fTransmittedAdded;
+  fStart = Now();
+  fNextReport = fStart + Ticks(fInterval);
+}
+
+void ProgressMonitor::EndOfEvent()
+{
+  if (!fActive) return;
+  fEventsDone.fetch_add(1, std::memory_order_relaxed);
+  G4long transmitted = (G4long)fRunAction->GetTransmitted();
+  if (transmitted != fTransmittedAdded) {
+    fTransmitted.fetch_add(transmitted - fTransmittedAdded,
+                           std::memory_order_relaxed);
+    fTransmittedAdded = transmitted;
+  }
+
+  // the first thread past the deadline moves it and reports
+  std::chrono::steady_clock::rep now = Now();
+  std::chrono::steady_clock::rep next =
+    fNextReport.load(std::memory_order_relaxed);
+  if (now >= next &&
+      fNextReport.compare_exchange_strong(next, now + Ticks(fInterval)))
+    Report(false);
+}
+
+void ProgressMonitor::EndOfRun()
+{
+  // after the workers: the master has the complete counts
+  if (fActive && G4Threading::IsMasterThread()) Report(true);
+}
+
+void ProgressMonitor::Report(G4bool final)
+{
+  G4double elapsed = std::chrono::duration<G4double>(
+    std::chrono::steady_clock::duration(Now() - fStart)).count();
+  G4double done = fEventsDone;
+  G4double requested = fEventsRequested;
+  G4double rate = (elapsed > 0.) ? (done - fEventsAtStart)/elapsed : 0.;
+  G4double eta = (rate > 0.) ? (requested - done)/rate : -1.;
+
+  // binomial error of T, propagated to mu = -ln(T)/(x*rho)
+  G4double n = done;
+  G4double transmission = (n > 0.) ? fTransmitted/n : 0.;
+  G4double areaDensity = fDetector->GetSize()*fDetector->GetDensity();
+  G4double mu = 0., sigma = 0.;
+  if (transmission > 0. && transmission < 1.) {
+    mu = -std::log(transmission)/areaDensity;
+    sigma = std::sqrt((1. - transmission)/(n*transmission))/areaDensity;
+  }
+
+  // lanes and the phantom have no single slab: T is not exp(-mu*x*rho)
+  G4bool slab = fDetector->GetNumberOfLanes() == 0 &&
+                !fDetector->GetPhantom()->IsActive();
+
+  std::ostringstream line;
+  line << "run " << fRunID
+       << " events " << (G4long)done << "/" << (G4long)requested
+       << " rate " << rate << "/s"
+       << " T " << transmission;
+  if (slab)
+    line << " mu " << mu/(cm2/g) << " +- " << sigma/(cm2/g) << " cm2/g";
+  line << " eta " << eta << " s"
+       << (final ? " done" : "");
+  G4cout << "progress: " << line.str() << G4endl;
+
+  // replaced in one rename: readers never see a partial line
+  G4String tmpName = fFileName + ".tmp";
+  {
+    std::ofstream out(tmpName);
+    out << line.str() << '\n';
+  }
+  std::rename(tmpName.c_str(), fFileName.c_str());
+}
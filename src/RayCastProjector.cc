@@ -0,0 +1,247 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/RayCastProjector.cc
+/// \brief Implementation of the RayCastProjector class
+//
+
+#include "RayCastProjector.hh"
+#include "RayCastProjectorMessenger.hh"
+#include "AttenuationCalculator.hh"
+
+#include "G4RunManager.hh"
+#include "G4TransportationManager.hh"
+#include "G4GeometryManager.hh"
+#include "G4Navigator.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Box.hh"
+#include "G4Material.hh"
+#include "G4Gamma.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#ifdef G4MULTITHREADED
+#include "G4WorkerThread.hh"
+#endif
+
+#include <thread>
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+RayCastProjector::RayCastProjector()
+:fMessenger(nullptr),fNy(256),fNz(256),fPitch(1*mm),fSourceDistance(0.),
+ fDetectorX(1*m),fNumberOfThreads(1),fFileName("Projection"),
+ fWorld(nullptr),fWorldHalfX(0.),fNumberOfMaterials(0)
+{
+  fMessenger = new RayCastProjectorMessenger(this);
+}
+
+RayCastProjector::~RayCastProjector()
+{
+  delete fMessenger;
+}
+
+void RayCastProjector::Project()
+{
+  if (fEnergies.empty()) {
+    G4cout << "\n--> warning from RayCastProjector::Project : "
+           << "no energy given (/testem/proj/addEnergy)" << G4endl;
+    return;
+  }
+
+  // mu(E) needs the physics tables
+  G4RunManager::GetRunManager()->BeamOn(0);
+
+  fWorld = G4TransportationManager::GetTransportationManager()
+             ->GetNavigatorForTracking()->GetWorldVolume();
+  fWorldHalfX = static_cast<const G4Box*>(
+                  fWorld->GetLogicalVolume()->GetSolid())->GetXHalfLength();
+
+  // linear attenuation coefficient of every material at every energy
+  const G4MaterialTable* materials = G4Material::GetMaterialTable();
+  fNumberOfMaterials = materials->size();
+  std::size_t nE = fEnergies.size();
+  fMu.assign(fNumberOfMaterials*nE, 0.);
+  AttenuationCalculator calculator;
+  for (std::size_t m = 0; m < fNumberOfMaterials; ++m) {
+    for (std::size_t k = 0; k < nE; ++k) {
+      fMu[m*nE + k] = calculator.ComputeCrossSectionPerVolume(
+                          G4Gamma::Definition(), fEnergies[k], (*materials)[m]);
+    }
+  }
+
+  fImage.assign(nE*fNy*fNz, 0.f);
+
+  G4GeometryManager* geometry = G4GeometryManager::GetInstance();
+  G4bool wasClosed = geometry->IsGeometryClosed();
+  if (!wasClosed) geometry->CloseGeometry(true, false, nullptr);
+
+  G4Timer timer;
+  timer.Start();
+
+  G4int nThreads = std::max(fNumberOfThreads, 1);
+#ifndef G4MULTITHREADED
+  // the logical volumes are not split per thread in a sequential build
+  nThreads = 1;
+#endif
+  std::atomic<G4int> nextRow(0);
+  std::atomic<G4int> stuckRays(0);
+  if (nThreads == 1) {
+    ProjectRows(nextRow, stuckRays);
+  } else {
+    std::vector<std::thread> threads;
+    for (G4int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([this, &nextRow, &stuckRays]() {
+#ifdef G4MULTITHREADED
+        // thread-local copy of the geometry data, as for a worker thread
+        G4WorkerThread::BuildGeometryAndPhysicsVector();
+#endif
+        ProjectRows(nextRow, stuckRays);
+#ifdef G4MULTITHREADED
+        G4WorkerThread::DestroyGeometryAndPhysicsVector();
+#endif
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+  }
+
+  timer.Stop();
+  if (!wasClosed) geometry->OpenGeometry(nullptr);
+
+  G4double rays = (G4double)fNy*fNz;
+  G4cout << "\n RayCastProjector: " << fNy << "x" << fNz << " rays, "
+         << nE << " energies, " << nThreads << " threads, "
+         << timer.GetRealElapsed() << " s";
+  if (timer.GetRealElapsed() > 0.)
+    G4cout << " (" << rays/timer.GetRealElapsed() << " rays/s)";
+  G4cout << G4endl;
+  if (stuckRays > 0) {
+    G4cout << "\n--> warning from RayCastProjector::Project : "
+           << stuckRays.load() << " rays got stuck on a boundary,"
+           << " their pixels are NaN" << G4endl;
+  }
+
+  Write();
+}
+
+void RayCastProjector::ProjectRows(std::atomic<G4int>& nextRow,
+                                   std::atomic<G4int>& stuckRays)
+{
+  G4Navigator navigator;
+  navigator.SetWorldVolume(const_cast<G4VPhysicalVolume*>(fWorld));
+
+  std::vector<G4double> pathLength(fNumberOfMaterials, 0.);
+  std::vector<std::size_t> visited;
+
+  for (G4int iz = nextRow++; iz < fNz; iz = nextRow++) {
+    for (G4int iy = 0; iy < fNy; ++iy) {
+      if (!TraceRay(iy, iz, navigator, pathLength, visited)) ++stuckRays;
+    }
+  }
+}
+
+G4bool RayCastProjector::TraceRay(G4int iy, G4int iz, G4Navigator& navigator,
+                                  std::vector<G4double>& pathLength,
+                                  std::vector<std::size_t>& visited)
+{
+  G4ThreeVector pixel(fDetectorX, (iy + 0.5 - 0.5*fNy)*fPitch,
+                                  (iz + 0.5 - 0.5*fNz)*fPitch);
+  G4ThreeVector origin;
+  if (fSourceDistance > 0.) origin.set(fDetectorX - fSourceDistance, 0., 0.);
+  else                      origin.set(-0.9999*fWorldHalfX, pixel.y(), pixel.z());
+
+  G4ThreeVector direction = (pixel - origin).unit();
+  G4double remaining = (pixel - origin).mag();
+
+  // geometric path length per material, up to the detector plane
+  G4ThreeVector position = origin;
+  G4VPhysicalVolume* volume =
+    navigator.LocateGlobalPointAndSetup(position, &direction, false, false);
+  G4int zeroSteps = 0;
+  G4bool stuck = false;
+  while (volume && remaining > 0.) {
+    G4double safety = 0.;
+    G4double step = navigator.ComputeStep(position, direction, remaining, safety);
+    step = std::min(step, remaining);
+
+    // a few zero steps are normal on boundaries, many mean we are stuck
+    if (step <= 0.) {
+      if (++zeroSteps > 10) { stuck = true; break; }
+    } else {
+      zeroSteps = 0;
+    }
+
+    // for parameterised volumes the navigator has set the voxel material
+    std::size_t index = volume->GetLogicalVolume()->GetMaterial()->GetIndex();
+    if (pathLength[index] == 0.) visited.push_back(index);
+    pathLength[index] += step;
+
+    position += step*direction;
+    remaining -= step;
+    navigator.SetGeometricallyLimitedStep();
+    volume = navigator.LocateGlobalPointAndSetup(position, &direction, true);
+  }
+
+  // T = exp(-sum over materials of mu*l), one image per energy;
+  // the path of a stuck ray is incomplete, its pixels are marked NaN
+  std::size_t nE = fEnergies.size();
+  std::size_t pixelIndex = (std::size_t)iz*fNy + iy;
+  for (std::size_t k = 0; k < nE; ++k) {
+    G4double opticalDepth = 0.;
+    for (std::size_t index : visited)
+      opticalDepth += fMu[index*nE + k]*pathLength[index];
+    fImage[k*fNy*fNz + pixelIndex] = stuck ?
+      std::numeric_limits<float>::quiet_NaN() : (float)std::exp(-opticalDepth);
+  }
+
+  for (std::size_t index : visited) pathLength[index] = 0.;
+  visited.clear();
+  return !stuck;
+}
+
+void RayCastProjector::Write() const
+{
+  std::ofstream raw(fFileName + ".raw", std::ios::binary);
+  if (!raw.is_open()) {
+    G4cout << "Projection file is not open!!!!" << G4endl;
+    return;
+  }
+  raw.write(reinterpret_cast<const char*>(fImage.data()),
+            fImage.size()*sizeof(float));
+
+  std::ofstream hdr(fFileName + ".hdr");
+  hdr << "# float32 transmission, y fastest, then z, then energy" << '\n';
+  hdr << "# NaN marks a ray stuck on a boundary" << '\n';
+  hdr << "ny" << '\t' << fNy << '\n';
+  hdr << "nz" << '\t' << fNz << '\n';
+  hdr << "pitch(mm)" << '\t' << fPitch/mm << '\n';
+  hdr << "detectorX(mm)" << '\t' << fDetectorX/mm << '\n';
+  hdr << "sourceDistance(mm)" << '\t' << fSourceDistance/mm << '\n';
+  hdr << "energies(MeV)";
+  for (G4double energy : fEnergies) hdr << '\t' << energy/MeV;
+  hdr << '\n';
+}
@@ -0,0 +1,163 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/RayCastProjectorMessenger.cc
+/// \brief Implementation of the RayCastProjectorMessenger class
+//
+
+#include "RayCastProjectorMessenger.hh"
+
+#include "RayCastProjector.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+RayCastProjectorMessenger::RayCastProjectorMessenger(RayCastProjector* proj)
+:G4UImessenger(),fProjector(proj),fProjDir(nullptr),fNyCmd(nullptr),
+ fNzCmd(nullptr),fPitchCmd(nullptr),fSourceCmd(nullptr),fDetectorCmd(nullptr),
+ fEnergyCmd(nullptr),fClearCmd(nullptr),fThreadsCmd(nullptr),fFileCmd(nullptr),
+ fRunCmd(nullptr)
+{ 
+  fProjDir = new G4UIdirectory("/testem/proj/");
+  fProjDir->SetGuidance("analytic ray-cast projection commands");
+
+  fNyCmd = new G4UIcmdWithAnInteger("/testem/proj/setPixelsY",this);
+  fNyCmd->SetGuidance("Set number of detector pixels along y.");
+  fNyCmd->SetParameterName("ny",false);
+  fNyCmd->SetRange("ny>0");
+  fNyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fNyCmd->SetToBeBroadcasted(false);
+
+  fNzCmd = new G4UIcmdWithAnInteger("/testem/proj/setPixelsZ",this);
+  fNzCmd->SetGuidance("Set number of detector pixels along z.");
+  fNzCmd->SetParameterName("nz",false);
+  fNzCmd->SetRange("nz>0");
+  fNzCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fNzCmd->SetToBeBroadcasted(false);
+
+  fPitchCmd = new G4UIcmdWithADoubleAndUnit("/testem/proj/setPitch",this);
+  fPitchCmd->SetGuidance("Set detector pixel pitch.");
+  fPitchCmd->SetParameterName("pitch",false);
+  fPitchCmd->SetRange("pitch>0.");
+  fPitchCmd->SetUnitCategory("Length");
+  fPitchCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPitchCmd->SetToBeBroadcasted(false);
+
+  fSourceCmd = new G4UIcmdWithADoubleAndUnit("/testem/proj/setSourceDistance",this);
+  fSourceCmd->SetGuidance("Set source to detector distance of a point source.");
+  fSourceCmd->SetGuidance("0 gives a parallel beam along +x.");
+  fSourceCmd->SetParameterName("dist",false);
+  fSourceCmd->SetRange("dist>=0.");
+  fSourceCmd->SetUnitCategory("Length");
+  fSourceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fSourceCmd->SetToBeBroadcasted(false);
+
+  fDetectorCmd = new G4UIcmdWithADoubleAndUnit("/testem/proj/setDetectorX",this);
+  fDetectorCmd->SetGuidance("Set x position of the detector plane.");
+  fDetectorCmd->SetParameterName("x",false);
+  fDetectorCmd->SetUnitCategory("Length");
+  fDetectorCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fDetectorCmd->SetToBeBroadcasted(false);
+
+  fEnergyCmd = new G4UIcmdWithADoubleAndUnit("/testem/proj/addEnergy",this);
+  fEnergyCmd->SetGuidance("Add a photon energy: one image per energy.");
+  fEnergyCmd->SetParameterName("E",false);
+  fEnergyCmd->SetRange("E>0.");
+  fEnergyCmd->SetUnitCategory("Energy");
+  fEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEnergyCmd->SetToBeBroadcasted(false);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testem/proj/clearEnergies",this);
+  fClearCmd->SetGuidance("Remove all energies.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearCmd->SetToBeBroadcasted(false);
+
+  fThreadsCmd = new G4UIcmdWithAnInteger("/testem/proj/setThreads",this);
+  fThreadsCmd->SetGuidance("Set number of threads sharing the image rows.");
+  fThreadsCmd->SetParameterName("nt",false);
+  fThreadsCmd->SetRange("nt>0");
+  fThreadsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fThreadsCmd->SetToBeBroadcasted(false);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/proj/setFileName",this);
+  fFileCmd->SetGuidance("Set output name (.raw and .hdr are appended).");
+  fFileCmd->SetParameterName("name",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fFileCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithoutParameter("/testem/proj/run",this);
+  fRunCmd->SetGuidance("Compute and write the transmission images.");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+}
+
+RayCastProjectorMessenger::~RayCastProjectorMessenger()
+{
+  delete fNyCmd;
+  delete fNzCmd;
+  delete fPitchCmd;
+  delete fSourceCmd;
+  delete fDetectorCmd;
+  delete fEnergyCmd;
+  delete fClearCmd;
+  delete fThreadsCmd;
+  delete fFileCmd;
+  delete fRunCmd;
+  delete fProjDir;
+}
+
+void RayCastProjectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fNyCmd )
+   { fProjector->SetNumberOfPixelsY(fNyCmd->GetNewIntValue(newValue));}
+
+  if( command == fNzCmd )
+   { fProjector->SetNumberOfPixelsZ(fNzCmd->GetNewIntValue(newValue));}
+
+  if( command == fPitchCmd )
+   { fProjector->SetPixelPitch(fPitchCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fSourceCmd )
+   { fProjector->SetSourceDistance(fSourceCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fDetectorCmd )
+   { fProjector->SetDetectorPosition(fDetectorCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEnergyCmd )
+   { fProjector->AddEnergy(fEnergyCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fClearCmd )
+   { fProjector->ClearEnergies();}
+
+  if( command == fThreadsCmd )
+   { fProjector->SetNumberOfThreads(fThreadsCmd->GetNewIntValue(newValue));}
+
+  if( command == fFileCmd )
+   { fProjector->SetFileName(newValue);}
+
+  if( command == fRunCmd )
+   { fProjector->Project();}
+}
@@ -32,36 +32,177 @@
 #include "RunAction.hh"
 #include "DetectorConstruction.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "SpectrumSampler.hh"
+#include "ExitFaceScorer.hh"
+#include "Checkpoint.hh"
+#include "ProgressMonitor.hh"
+#include "MemoryReport.hh"
+#include "EventWatchdog.hh"
+#include "PerturbationEstimator.hh"
+#include "ExpectedValueEstimator.hh"
+#include "SteppingAction.hh"
+#include "StackingAction.hh"
 #include "G4Run.hh"
+#include "G4Material.hh"
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
 #include "G4ProcessManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4Electron.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 #include "WriteOutputFile.hh"
+#include "AttenuationCalculator.hh"
+
+#include <iostream>
+
+namespace { G4Mutex mergeMutex = G4MUTEX_INITIALIZER; }
+
+RunAction* RunAction::fMasterRunAction = nullptr;
 
 RunAction::RunAction(DetectorConstruction* det, PrimaryGeneratorAction* kin)
-:G4UserRunAction(),fDetector(det), fPrimary(kin)
+:G4UserRunAction(),fDetector(det), fPrimary(kin), fExitFaceScorer(nullptr),
+ fRayGridNy(0),fCheckpoint(nullptr),fEventOffset(0),
+ fProgressMonitor(nullptr),fMemoryReport(nullptr),fWatchdog(nullptr),
+ fPerturbation(nullptr),fExpectedValue(nullptr),fSteppingAction(nullptr),fStackingAction(nullptr),
+  fNumberOfSteps(0),fNumberOfKilled(0)
 { 
 gammaTransmitted = 0;
+fPrimarySurvived = 0;
 numberOfEvents = 0;
+fExitFaceScorer = new ExitFaceScorer();
+fCheckpoint = new Checkpoint(this);
+fProgressMonitor = new ProgressMonitor(this, det);
+fMemoryReport = new MemoryReport(det);
+fWatchdog = new EventWatchdog();
+fPerturbation = new PerturbationEstimator(det);
+fExpectedValue = new ExpectedValueEstimator(det);
 }
 
 RunAction::~RunAction()
-{ }
+{ 
+  delete fExpectedValue;
+  delete fPerturbation;
+  delete fWatchdog;
+  delete fMemoryReport;
+  delete fProgressMonitor;
+  delete fCheckpoint;
+  delete fExitFaceScorer;
+}
 
-void RunAction::BeginOfRunAction(const G4Run*)
+void RunAction::BeginOfRunAction(const G4Run* aRun)
 {
   //GetCuts();
   gammaTransmitted = 0;
+  fPrimarySurvived = 0;
   numberOfEvents = 0;
+  if (IsMaster()) fMasterRunAction = this;
+
+  fBinTransmitted.clear();
+  fBinTotal.clear();
+  if (fPrimary->UseSpectrum()) {
+    fBinTransmitted.assign(fPrimary->GetSpectrum()->GetNumberOfBins(), 0.);
+    fPrimary->ResetSampledPerBin();
+  }
+
+  fRayTransmitted.clear();
+  fRayTotal.clear();
+  fRayGridNy = fPrimary->GetRayGridNy();
+  G4int nRays = fRayGridNy*fPrimary->GetRayGridNz();
+  if (nRays > 0) {
+    fRayTransmitted.assign(nRays, 0.);
+    fPrimary->ResetSampledPerRay(nRays);
+  }
+
+  // the fast simulation absorbs the collided primaries: no broad beam
+  if (fExitFaceScorer->IsActive() && fDetector->GetFastSimulation()) {
+    if (IsMaster())
+      G4cout << "\n--> warning from RunAction::BeginOfRunAction : the fast "
+             << "simulation absorbs collided primaries, exit-face scoring off"
+             << G4endl;
+    fExitFaceScorer->SetActive(false);
+  }
+  if (fExitFaceScorer->IsActive()) {
+    G4double emax = fPrimary->GetInitialEnergy();
+    if (fPrimary->UseSpectrum()) emax = fPrimary->GetSpectrum()->GetMaxEnergy();
+    fExitFaceScorer->Reset(emax);
+  }
+
+  // physics tables are built at this point: resize the slab for mu*x target;
+  // the geometry is shared, only the master changes it
+  if (IsMaster() && fDetector->GetAutoThickness()) {
+    G4double energy = fPrimary->GetInitialEnergy();
+    if (fPrimary->UseSpectrum()) energy = fPrimary->GetSpectrum()->GetMeanEnergy();
+    fDetector->OptimizeThickness(
+                fPrimary->GetParticleGun()->GetParticleDefinition(), energy);
+  }
+
+  // cross sections at the beam energies, from the master to the workers;
+  // reset before the checkpoint restores the tallies
+  std::vector<G4double> energies(1, fPrimary->GetInitialEnergy());
+  if (fPrimary->UseSpectrum()) {
+    const SpectrumSampler* spectrum = fPrimary->GetSpectrum();
+    energies.clear();
+    for (G4int bin = 0; bin < spectrum->GetNumberOfBins(); ++bin)
+      energies.push_back(spectrum->GetEnergy(bin));
+  }
+  fPerturbation->BeginOfRun(
+    fPrimary->GetParticleGun()->GetParticleDefinition(), energies,
+    (!IsMaster() && fMasterRunAction) ? fMasterRunAction->fPerturbation : nullptr);
+  fExpectedValue->BeginOfRun(
+    fPrimary->GetParticleGun()->GetParticleDefinition());
+
+  // continue a run from its checkpoint
+  fEventOffset = fCheckpoint->BeginOfRun(aRun);
+  fProgressMonitor->BeginOfRun(aRun, fEventOffset);
+  // physics tables are built: the end of initialization for the report
+  fMemoryReport->BeginOfRun(aRun->GetRunID());
+  fWatchdog->BeginOfRun(aRun, fEventOffset);
+  if (fWatchdog->GetReplayedEvent() >= 0)
+    fPrimary->SetEventOffset(fWatchdog->GetReplayedEvent());
+  // the options of the run are known: hot paths with only their checks
+  if (fSteppingAction) fSteppingAction->BeginOfRun();
+  if (fStackingAction) fStackingAction->BeginOfRun();
+
+  fNumberOfSteps = 0;
+  fNumberOfKilled = 0;
+  fTimer.Start();
 }
 
 void RunAction::EndOfRunAction(const G4Run* aRun)
 { 
+ fTimer.Stop();
+ fProgressMonitor->EndOfRun();
+ // generator counts of this thread; an MT master has them merged already
+ if (!IsMaster() || !G4Threading::IsMultithreadedApplication()) {
+   fBinTotal = fPrimary->GetSampledPerBin();
+   fRayTotal = fPrimary->GetSampledPerRay();
+ }
+
+ // workers hand their tallies to the master, which writes the results
+ if (!IsMaster() && fMasterRunAction) {
+   G4AutoLock lock(&mergeMutex);
+   fMasterRunAction->Merge(*this);
+   return;
+ }
+
+ // completed by an earlier job, whose results are already written
+ if (fCheckpoint->IsSkipping()) return;
+
  G4cout << "End of Run" << G4endl;
+ if (fTimer.GetRealElapsed() > 0.) {
+   G4cout << "steps: " << fNumberOfSteps << " in " << fTimer.GetRealElapsed()
+          << " s, " << fNumberOfSteps/fTimer.GetRealElapsed() << " steps/s" << G4endl;
+   G4cout << "events: " << aRun->GetNumberOfEvent() << " in "
+          << fTimer.GetRealElapsed() << " s, "
+          << aRun->GetNumberOfEvent()/fTimer.GetRealElapsed() << " events/s"
+          << G4endl;
+ }
+ if (fNumberOfKilled > 0)
+   G4cout << "secondaries killed below threshold: " << fNumberOfKilled << G4endl;
+ fWatchdog->EndOfRun();
 
- numberOfEvents = aRun->GetNumberOfEvent();
+ numberOfEvents = aRun->GetNumberOfEvent() + fEventOffset;
 
  G4double primaryParticleEnergy = fPrimary->GetInitialEnergy();
 
@@ -74,15 +215,246 @@ void RunAction::EndOfRunAction(const G4Run* aRun)
 
  G4double gammaAttenuationCoefficient = -(std::log(gammaTransmittedFraction))/(targetThickness*absorberMaterialDensity);
  
+ // for a spectrum the effective mu is quoted at the mean energy
+ if (fPrimary->UseSpectrum()) {
+   primaryParticleEnergy = fPrimary->GetSpectrum()->GetMeanEnergy();
+   EndOfSpectrumRun(numberOfEvents);
+ }
+ fExpectedValue->EndOfRun(primaryParticleEnergy, gammaTransmitted, numberOfEvents);
+
+ if (fExitFaceScorer->IsActive()) fExitFaceScorer->Write(numberOfEvents);
+ fPerturbation->EndOfRun();
+ EndOfRemovalRun(numberOfEvents);
+ if (!fRayTransmitted.empty()) EndOfRayRun();
+
+ // lanes of different materials have no common mu
  WriteOutputFile* output = WriteOutputFile::GetInstance();
- output -> Fill(primaryParticleEnergy/MeV,  gammaAttenuationCoefficient/(cm*cm/g));
+ if (!fPrimary->UseLanes())
+   output -> Fill(primaryParticleEnergy/MeV,  gammaAttenuationCoefficient/(cm*cm/g));
+
+ fMemoryReport->EndOfRun(aRun->GetRunID());
+ fCheckpoint->EndOfRun();
 } 
 
+void RunAction::EndOfSpectrumRun(G4double nEvents)
+{
+ const SpectrumSampler* spectrum = fPrimary->GetSpectrum();
+ const std::vector<G4double>& sampled = fBinTotal;
+ G4double areaDensity = fDetector->GetSize()*fDetector->GetDensity();
+
+ WriteOutputFile* output = WriteOutputFile::GetInstance();
+ for (G4int bin = 0; bin < spectrum->GetNumberOfBins(); ++bin) {
+   // no transmitted primary: no finite mu, 0 is written
+   G4double mu = 0.;
+   if (sampled[bin] > 0. && fBinTransmitted[bin] > 0.)
+     mu = -std::log(fBinTransmitted[bin]/sampled[bin])/areaDensity;
+   output -> FillSpectrumBin(spectrum->GetEnergy(bin)/MeV, spectrum->GetWeight(bin),
+                             sampled[bin], fBinTransmitted[bin], mu/(cm*cm/g));
+ }
+
+ G4double transmission = gammaTransmitted/nEvents;
+ G4cout << "spectrum-weighted transmission: " << transmission
+        << " +- " << std::sqrt(transmission*(1.-transmission)/nEvents) << G4endl;
+ G4double mu = (transmission > 0.) ? -std::log(transmission)/areaDensity : 0.;
+ output -> FillSpectrumSummary(transmission, mu/(cm*cm/g));
+}
+
+G4bool RunAction::IsRemovalRun()
+{
+ const G4ParticleDefinition* particle =
+   fPrimary->GetParticleGun()->GetParticleDefinition();
+ if (!particle) return false;
+ const G4String& type = particle->GetParticleType();
+ return (type == "baryon" || type == "meson" || type == "nucleus");
+}
+
+void RunAction::EndOfRemovalRun(G4double nEvents)
+{
+ if (!IsRemovalRun()) return;
+ const G4ParticleDefinition* particle =
+   fPrimary->GetParticleGun()->GetParticleDefinition();
+
+ // cross sections at the gun energy, in the slab material
+ G4Material* material = fDetector->GetMaterial();
+ G4double energy = fPrimary->GetInitialEnergy();
+ AttenuationCalculator calculator;
+ G4double removal = calculator.GetRemovalCrossSectionPerVolume(particle,
+                                                     energy, material);
+ G4double total = calculator.GetHadronicCrossSectionPerVolume(particle,
+                                                     energy, material);
+ G4double density = material->GetDensity();
+ G4double areaDensity = fDetector->GetSize()*density;
+
+ // survivors include primaries scattered forward; charged primaries
+ // stopped by ionisation count as removed
+ G4double survival = fPrimarySurvived/nEvents;
+ G4double mu = 0., error = 0.;
+ if (survival > 0.) {
+   mu = -std::log(survival)/areaDensity;
+   error = std::sqrt(survival*(1.-survival)/nEvents)/(survival*areaDensity);
+ }
+ // a charged primary loses energy on every step: none is uncollided, and
+ // the MC uncollided mu/rho is left at zero
+ G4bool charged = (particle->GetPDGCharge() != 0.);
+ G4double uncollided = gammaTransmitted/nEvents;
+ G4double muUncollided =
+   (uncollided > 0.) ? -std::log(uncollided)/areaDensity : 0.;
+
+ G4cout << particle->GetParticleName() << " removal mu/rho: "
+        << mu/(cm*cm/g) << " +- " << error/(cm*cm/g) << " cm2/g (MC), "
+        << removal/density/(cm*cm/g) << " cm2/g (inelastic cross section)"
+        << G4endl;
+ G4cout << particle->GetParticleName() << " total mu/rho: ";
+ if (charged) G4cout << "none uncollided (charged primary), ";
+ else G4cout << muUncollided/(cm*cm/g) << " cm2/g (MC uncollided), ";
+ G4cout << total/density/(cm*cm/g) << " cm2/g (hadronic cross sections)"
+        << G4endl;
+ if (removal == 0.)
+   G4cout << "\n--> warning from RunAction::EndOfRemovalRun : no inelastic "
+          << "cross section, add hadronic physics (/testem/phys/addPhysics)"
+          << G4endl;
+
+ WriteOutputFile::GetInstance() -> FillRemoval(particle->GetParticleName(),
+                    energy/MeV, mu/(cm*cm/g), error/(cm*cm/g),
+                    removal/density/(cm*cm/g), muUncollided/(cm*cm/g),
+                    total/density/(cm*cm/g));
+}
+
+void RunAction::EndOfRayRun()
+{
+ const std::vector<G4double>& sampled = fRayTotal;
+ G4int ny = fRayGridNy;
+
+ WriteOutputFile* output = WriteOutputFile::GetInstance();
+ if (fPrimary->UseLanes()) {
+   // one mu per lane; the lanes share the slab thickness
+   G4double energy = fPrimary->GetInitialEnergy();
+   for (std::size_t lane = 0; lane < fRayTransmitted.size(); ++lane) {
+     G4Material* material = fDetector->GetLaneMaterial(lane);
+     G4double areaDensity = fDetector->GetSize()*material->GetDensity();
+     G4double transmission =
+       (sampled[lane] > 0.) ? fRayTransmitted[lane]/sampled[lane] : 0.;
+     G4double mu = 0., error = 0.;
+     if (transmission > 0. && transmission < 1.) {
+       mu = -std::log(transmission)/areaDensity;
+       error = std::sqrt((1.-transmission)/(sampled[lane]*transmission))
+               /areaDensity;
+     }
+     G4cout << "lane " << lane << " (" << material->GetName() << "): mu/rho = "
+            << mu/(cm*cm/g) << " +- " << error/(cm*cm/g) << " cm2/g" << G4endl;
+     output -> FillLane(lane, material->GetName(), energy/MeV, sampled[lane],
+                        fRayTransmitted[lane], mu/(cm*cm/g), error/(cm*cm/g));
+   }
+   return;
+ }
+
+ // -ln(T) of each ray is its line integral of mu
+ if (!fPrimary->UseRaster()) {
+   for (std::size_t ray = 0; ray < fRayTransmitted.size(); ++ray) {
+     G4double lineIntegral = 0.;
+     if (sampled[ray] > 0. && fRayTransmitted[ray] > 0.)
+       lineIntegral = -std::log(fRayTransmitted[ray]/sampled[ray]);
+     output -> FillRay(ray%ny, ray/ny, sampled[ray], fRayTransmitted[ray],
+                       lineIntegral);
+   }
+   return;
+ }
+
+ // raster: uncollided transmission image, y fastest
+ std::vector<float> image(fRayTransmitted.size(), 0.f);
+ for (std::size_t pixel = 0; pixel < image.size(); ++pixel)
+   if (sampled[pixel] > 0.) image[pixel] = fRayTransmitted[pixel]/sampled[pixel];
+ output -> WriteImage("Radiography", ny, image.size()/ny,
+                      fPrimary->GetRasterPitch(), image);
+}
+
+void RunAction::Merge(const RunAction& worker)
+{
+ gammaTransmitted += worker.gammaTransmitted;
+ fPrimarySurvived += worker.fPrimarySurvived;
+ fNumberOfSteps   += worker.fNumberOfSteps;
+ fNumberOfKilled  += worker.fNumberOfKilled;
+
+ auto add = [](std::vector<G4double>& to, const std::vector<G4double>& from) {
+   if (to.size() < from.size()) to.resize(from.size(), 0.);
+   for (std::size_t i = 0; i < from.size(); ++i) to[i] += from[i];
+ };
+ add(fBinTransmitted, worker.fBinTransmitted);
+ add(fBinTotal,       worker.fBinTotal);
+ add(fRayTransmitted, worker.fRayTransmitted);
+ add(fRayTotal,       worker.fRayTotal);
+ if (fRayGridNy == 0) fRayGridNy = worker.fRayGridNy;
+
+ if (fExitFaceScorer->IsActive())
+   fExitFaceScorer->Merge(*worker.fExitFaceScorer);
+ fMemoryReport->MergeStack(*worker.fMemoryReport);
+ fWatchdog->Merge(*worker.fWatchdog);
+ fPerturbation->Merge(*worker.fPerturbation);
+ fExpectedValue->Merge(*worker.fExpectedValue);
+}
+
+void RunAction::WriteTallies(std::ostream& os) const
+{
+ auto put = [&os](const std::vector<G4double>& tally) {
+   os << tally.size();
+   for (G4double val : tally) os << ' ' << val;
+   os << '\n';
+ };
+ // generator counts only for the tallies in use in this run
+ const std::vector<G4double> none;
+ os << gammaTransmitted << ' ' << fPrimarySurvived << '\n';
+ put(fBinTransmitted);
+ put(fBinTransmitted.empty() ? none : fPrimary->GetSampledPerBin());
+ put(fRayTransmitted);
+ put(fRayTransmitted.empty() ? none : fPrimary->GetSampledPerRay());
+ fExitFaceScorer->WriteState(os);
+ fPerturbation->WriteState(os);
+ fExpectedValue->WriteState(os);
+}
+
+G4bool RunAction::ReadTallies(std::istream& is, G4int eventsDone)
+{
+ // the run must be set up as when the checkpoint was written
+ auto get = [&is](std::vector<G4double>& tally, std::size_t size) {
+   std::size_t n = 0;
+   is >> n;
+   if (!is || n != size) return false;
+   tally.resize(n);
+   for (G4double& val : tally) is >> val;
+   return bool(is);
+ };
+ G4double transmitted = 0., survived = 0.;
+ std::vector<G4double> binTransmitted, binTotal, rayTransmitted, rayTotal;
+ is >> transmitted >> survived;
+ if (!get(binTransmitted, fBinTransmitted.size()) ||
+     !get(binTotal, fBinTransmitted.size()) ||
+     !get(rayTransmitted, fRayTransmitted.size()) ||
+     !get(rayTotal, fRayTransmitted.size())) return false;
+ if (!fExitFaceScorer->ReadState(is)) return false;
+ if (!fPerturbation->ReadState(is)) return false;
+ if (!fExpectedValue->ReadState(is)) return false;
+
+ gammaTransmitted = transmitted;
+ fPrimarySurvived = survived;
+ fBinTransmitted = binTransmitted;
+ fRayTransmitted = rayTransmitted;
+ fPrimary->RestoreSampled(binTotal, rayTotal, eventsDone);
+ return true;
+}
+
 void  RunAction::TransmittedGammaNumber()
 {
   gammaTransmitted += 1;
+  if (!fBinTransmitted.empty()) fBinTransmitted[fPrimary->GetCurrentBin()] += 1;
+  if (!fRayTransmitted.empty()) fRayTransmitted[fPrimary->GetCurrentRay()] += 1;
  //G4cout << "gamma transmitted " << G4endl;
 }
 
+void RunAction::TransmittedInLane(G4int lane)
+{
+  gammaTransmitted += 1;
+  fRayTransmitted[lane] += 1;
+}
+
 
 
@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/SlabFastSimModel.cc
+/// \brief Implementation of the SlabFastSimModel class
+//
+
+#include "SlabFastSimModel.hh"
+#include "DetectorConstruction.hh"
+#include "AttenuationCalculator.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Gamma.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+
+SlabFastSimModel::SlabFastSimModel(const G4String& name, G4Region* envelope,
+                                   DetectorConstruction* det)
+:G4VFastSimulationModel(name, envelope),fDetector(det),fCalculator(nullptr),
+ fLastEnergy(-1.),fLastMaterial(nullptr),fLastSigma(0.)
+{
+  fCalculator = new AttenuationCalculator();
+}
+
+SlabFastSimModel::~SlabFastSimModel()
+{
+  delete fCalculator;
+}
+
+G4bool SlabFastSimModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle == G4Gamma::Definition();
+}
+
+G4bool SlabFastSimModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  if (!fDetector->GetFastSimulation()) return false;
+
+  // primaries only, once, when they come in through the slab surface
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  if (track->GetParentID() != 0) return false;
+  return track->GetStep()->GetPreStepPoint()->GetStepStatus() == fGeomBoundary;
+}
+
+void SlabFastSimModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  G4ThreeVector position  = fastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector direction = fastTrack.GetPrimaryTrackLocalDirection();
+
+  G4double distanceToOut =
+    fastTrack.GetEnvelopeSolid()->DistanceToOut(position, direction);
+
+  G4double sigma = CrossSection(track->GetKineticEnergy(), track->GetMaterial());
+  G4double distance = DBL_MAX;
+  if (sigma > 0.) distance = -std::log(1. - G4UniformRand())/sigma;
+
+  if (distance >= distanceToOut) {
+    // uncollided: stop just short of the exit face so that the next
+    // (transportation) step is the one crossing into the world
+    G4double tolerance =
+      10.*G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+    distance = std::max(distanceToOut - tolerance, 0.);
+  } else {
+    // collided: absorbed at the interaction point, so that no later free
+    // path sampled by full tracking can carry it out of the slab
+    fastStep.KillPrimaryTrack();
+    fastStep.ProposeTotalEnergyDeposited(track->GetKineticEnergy());
+  }
+
+  fastStep.ProposePrimaryTrackFinalPosition(position + distance*direction);
+  fastStep.ProposePrimaryTrackPathLength(distance);
+  fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime()
+                                        + distance/c_light);
+}
+
+G4double SlabFastSimModel::CrossSection(G4double energy,
+                                        const G4Material* material)
+{
+  if (energy != fLastEnergy || material != fLastMaterial) {
+    fLastEnergy   = energy;
+    fLastMaterial = material;
+    fLastSigma    = fCalculator->GetCrossSectionPerVolume(
+                               G4Gamma::Definition(), energy, material);
+  }
+  return fLastSigma;
+}
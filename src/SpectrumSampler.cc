@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/SpectrumSampler.cc
+/// \brief Implementation of the SpectrumSampler class
+//
+
+#include "SpectrumSampler.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+SpectrumSampler::SpectrumSampler()
+{ }
+
+SpectrumSampler::~SpectrumSampler()
+{ }
+
+G4bool SpectrumSampler::Load(const G4String& fileName)
+{
+  std::ifstream ifs(fileName);
+  if (!ifs.is_open()) {
+    G4cout << "\n--> warning from SpectrumSampler::Load : cannot open "
+           << fileName << G4endl;
+    return false;
+  }
+
+  std::vector<G4double> energy, weight;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    std::istringstream iss(line);
+    G4double e, w;
+    if (!(iss >> e >> w)) continue;
+    if (e <= 0. || w < 0.) {
+      G4cout << "\n--> warning from SpectrumSampler::Load : skipping line <"
+             << line << "> of " << fileName << G4endl;
+      continue;
+    }
+    energy.push_back(e*MeV);
+    weight.push_back(w);
+  }
+
+  G4double sum = 0.;
+  for (G4double w : weight) sum += w;
+  if (energy.empty() || sum <= 0.) {
+    G4cout << "\n--> warning from SpectrumSampler::Load : no usable bin in "
+           << fileName << G4endl;
+    return false;
+  }
+
+  fEnergy = energy;
+  fWeight = weight;
+  for (G4double& w : fWeight) w /= sum;
+  BuildAliasTable();
+
+  G4cout << " Spectrum " << fileName << ": " << fEnergy.size()
+         << " bins, mean energy " << GetMeanEnergy()/MeV << " MeV" << G4endl;
+  return true;
+}
+
+void SpectrumSampler::BuildAliasTable()
+{
+  // Vose's variant of the alias method
+  G4int n = (G4int)fWeight.size();
+  fProbability.assign(n, 1.);
+  fAlias.assign(n, 0);
+
+  std::vector<G4double> scaled(n);
+  std::vector<G4int> small, large;
+  for (G4int i = 0; i < n; ++i) {
+    scaled[i] = fWeight[i]*n;
+    fAlias[i] = i;
+    if (scaled[i] < 1.) small.push_back(i);
+    else                large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    G4int s = small.back(); small.pop_back();
+    G4int l = large.back(); large.pop_back();
+    fProbability[s] = scaled[s];
+    fAlias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.;
+    if (scaled[l] < 1.) small.push_back(l);
+    else                large.push_back(l);
+  }
+  // left-overs are 1 up to rounding
+  for (G4int i : large) fProbability[i] = 1.;
+  for (G4int i : small) fProbability[i] = 1.;
+}
+
+G4double SpectrumSampler::GetMeanEnergy() const
+{
+  G4double mean = 0.;
+  for (std::size_t i = 0; i < fEnergy.size(); ++i) mean += fEnergy[i]*fWeight[i];
+  return mean;
+}
+
+G4double SpectrumSampler::GetMaxEnergy() const
+{
+  G4double emax = 0.;
+  for (G4double e : fEnergy) emax = std::max(emax, e);
+  return emax;
+}
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/StackingAction.cc
+/// \brief Implementation of the StackingAction class
+//
+
+#include "StackingAction.hh"
+#include "RunAction.hh"
+#include "MemoryReport.hh"
+#include "PhysicsList.hh"
+#include "ScoringPolicies.hh"
+
+#include "G4Track.hh"
+#include "G4StackManager.hh"
+
+#include <type_traits>
+
+namespace {
+  // bits of the index of StackingAction::Table
+  enum Option {kKill = 1, kStack = 2, kNumberOfCombinations = 4};
+}
+
+StackingAction::StackingAction(RunAction* run, const PhysicsList* phys)
+:G4UserStackingAction(),fRunAction(run),fPhysicsList(phys),fClassify(nullptr)
+{
+  BeginOfRun();
+}
+
+StackingAction::~StackingAction()
+{ }
+
+template <std::size_t... Options>
+std::array<StackingAction::ClassifyFunction, sizeof...(Options)>
+StackingAction::Table(std::index_sequence<Options...>)
+{
+  return {{ &StackingAction::Classify<
+    std::conditional_t<(Options & kKill) != 0, KillBelowThreshold, NoKill>,
+    std::conditional_t<(Options & kStack) != 0, StackWatch, NoStackWatch> >... }};
+}
+
+void StackingAction::BeginOfRun()
+{
+  static const std::array<ClassifyFunction, kNumberOfCombinations> table =
+    Table(std::make_index_sequence<kNumberOfCombinations>());
+
+  G4int options = 0;
+  if (fPhysicsList->HasKillThresholds())          options |= kKill;
+  if (fRunAction->GetMemoryReport()->IsActive())  options |= kStack;
+  fClassify = table[options];
+}
+
+template <class Kill, class Stack>
+G4ClassificationOfNewTrack StackingAction::Classify(const G4Track* track)
+{
+  if (Kill::Killed(fPhysicsList, track)) {
+    fRunAction->CountKilledSecondary();
+    return fKill;
+  }
+
+  Stack::Update(fRunAction->GetMemoryReport(), stackManager);
+  return fUrgent;
+}
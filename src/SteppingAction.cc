@@ -27,65 +27,116 @@
 
 #include "G4ios.hh"
 #include <cmath> 
+#include <type_traits>
 #include "G4SteppingManager.hh"
 #include "G4Step.hh"
 #include "G4Track.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4VPhysicalVolume.hh"
+#include "G4VTouchable.hh"
 #include "SteppingAction.hh"
 #include "DetectorConstruction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "ScoringPolicies.hh"
+
+namespace {
+  // bits of the index of SteppingAction::Table
+  enum Option {kLanes = 1, kExitFace = 2, kInteractions = 4, kBudget = 8,
+               kExpectedValue = 16, kRemoval = 32, kNumberOfCombinations = 64};
+}
 
 SteppingAction::SteppingAction(PrimaryGeneratorAction* primary, 
 			       RunAction* run, 
 			       DetectorConstruction* det):
   primaryAction(primary), 
   runAction(run), 
-  detector(det) 
-{ }
+  detector(det),
+  fScore(nullptr)
+{
+  BeginOfRun();
+}
 
 SteppingAction::~SteppingAction()
 { }
 
-void SteppingAction::UserSteppingAction(const G4Step* aStep)
+template <std::size_t... Options>
+std::array<SteppingAction::ScoreFunction, sizeof...(Options)>
+SteppingAction::Table(std::index_sequence<Options...>)
+{
+  return {{ &SteppingAction::Score<
+    std::conditional_t<(Options & kLanes) != 0, LaneBeam, NarrowBeam>,
+    std::conditional_t<(Options & kExitFace) != 0, BroadBeam, NoExitFace>,
+    std::conditional_t<(Options & kInteractions) != 0,
+                       ProcessResolved, NoInteractions>,
+    std::conditional_t<(Options & kBudget) != 0, EventBudget, NoBudget>,
+    std::conditional_t<(Options & kExpectedValue) != 0,
+                       ExpectedValue, NoExpectedValue>,
+    std::conditional_t<(Options & kRemoval) != 0, RemovalBeam, NoRemoval> >... }};
+}
+
+void SteppingAction::BeginOfRun()
+{
+  static const std::array<ScoreFunction, kNumberOfCombinations> table =
+    Table(std::make_index_sequence<kNumberOfCombinations>());
+
+  G4int options = 0;
+  if (primaryAction->UseLanes())                    options |= kLanes;
+  if (runAction->GetExitFaceScorer()->IsActive())   options |= kExitFace;
+  if (runAction->GetPerturbation()->IsActive())     options |= kInteractions;
+  if (runAction->GetWatchdog()->IsActive())         options |= kBudget;
+  if (runAction->GetExpectedValue()->IsActive())    options |= kExpectedValue;
+  if (runAction->IsRemovalRun())                    options |= kRemoval;
+  fScore = table[options];
+}
+
+template <class Beam, class ExitFace, class Interactions, class Budget,
+          class Estimator, class Removal>
+void SteppingAction::Score(const G4Step* aStep)
 {
+  runAction->CountStep();
+  Budget::Step(runAction->GetWatchdog());
+
+  G4Track* track = aStep->GetTrack();
+  const G4VPhysicalVolume* world = detector->GetWorldVolume();
+
+  // interaction type of the primaries, for the perturbation report
+  Interactions::Step(runAction->GetPerturbation(), aStep, world);
+  // uncollided steps of the primary in the slab
+  Estimator::Step(runAction->GetExpectedValue(), aStep, world);
+
+  // only steps going from the target into the world are scored
+  if ((aStep->GetPreStepPoint()->GetPhysicalVolume() == world) ||
+      (track->GetNextVolume() != world)) return;
+
   // Retrieve the initial energy of particle
   G4double  primaryParticleEnergy = primaryAction->GetInitialEnergy();
 
   // Retrieve the current energy of particle
-  G4double  ParticleKineticEnergy = aStep->GetTrack()->GetKineticEnergy();
+  G4double  ParticleKineticEnergy = track->GetKineticEnergy();
   
  // Retrieve current direction
-  G4double  particleXMomentumDirection = 
-                            aStep->GetTrack()->GetMomentumDirection().x();
-  
- G4double  particleYMomentumDirection = 
-                            aStep->GetTrack()->GetMomentumDirection().y();
-  
-  G4double  particleZMomentumDirection = 
-                            aStep->GetTrack()->GetMomentumDirection().z();
-  
+  const G4ThreeVector& direction = track->GetMomentumDirection();
  
-  if (aStep ->GetTrack()->GetParentID() == 0)// Check if the particle is a primary
+  G4bool uncollided = false;
+  if (track->GetParentID() == 0)// Check if the particle is a primary
     {
-          // Check if the primary particle is going outside the target ...
-	  if ((aStep->GetPreStepPoint()->GetPhysicalVolume()->GetName() 
-	       != "World") && 
-	      (aStep->GetTrack()->GetNextVolume()->GetName() == "World") )
-	    { 
-	      if ((primaryParticleEnergy == ParticleKineticEnergy) 
-		  &&( particleXMomentumDirection == 1.)
- 		  &&( particleYMomentumDirection == 0.)
-		  &&( particleZMomentumDirection == 0.))
-		 // transmitted primary gamma 
-		 {runAction -> TransmittedGammaNumber();
-			//G4cout << "counted!!!!" << G4endl;
-		}  
-	    }
+      if ((primaryParticleEnergy == ParticleKineticEnergy) 
+          &&( direction.x() == 1.)
+          &&( direction.y() == 0.)
+          &&( direction.z() == 0.))
+         // transmitted primary gamma 
+         {Beam::Transmitted(runAction, aStep);
+          // straight through the slab: the path is its thickness
+          Interactions::Uncollided(runAction->GetPerturbation(), track,
+                                   detector->GetSize());
+          uncollided = true;
+        }  
     }
-}
-
-
 
+  // neutrons and ions: primaries surviving the slab
+  Removal::Exit(runAction, aStep);
 
+  // everything crossing the exit face: broad beam and buildup
+  ExitFace::Score(runAction->GetExitFaceScorer(), track, uncollided);
+}
@@ -0,0 +1,147 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/TableExporter.cc
+/// \brief Implementation of the TableExporter class
+//
+
+#include "TableExporter.hh"
+#include "TableExporterMessenger.hh"
+#include "AttenuationCalculator.hh"
+#include "AttenuationTable.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "PhysicsList.hh"
+
+#include "G4RunManager.hh"
+#include "G4ParticleGun.hh"
+#include "G4NistManager.hh"
+#include "G4Material.hh"
+#include "G4Version.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <limits>
+
+TableExporter::TableExporter(DetectorConstruction* det,
+                             PrimaryGeneratorAction* prim, PhysicsList* phys)
+:fDetector(det),fPrimary(prim),fPhysicsList(phys),fMessenger(nullptr),
+ fCalculator(nullptr),fEnergyMin(1*keV),fEnergyMax(100*MeV),
+ fNumberOfPoints(1000),fFileName("AttenuationTable.mutb")
+{
+  fMessenger = new TableExporterMessenger(this);
+  fCalculator = new AttenuationCalculator();
+}
+
+TableExporter::~TableExporter()
+{
+  delete fCalculator;
+  delete fMessenger;
+}
+
+void TableExporter::Write()
+{
+  if (fEnergyMin <= 0. || fEnergyMax <= fEnergyMin || fNumberOfPoints < 2) {
+    G4cout << "\n--> warning from TableExporter::Write : invalid range "
+           << G4BestUnit(fEnergyMin,"Energy") << " - "
+           << G4BestUnit(fEnergyMax,"Energy") << G4endl;
+    return;
+  }
+
+  // the cross sections need the physics tables
+  G4RunManager::GetRunManager()->BeamOn(0);
+
+  const G4ParticleDefinition* particle =
+    fPrimary->GetParticleGun()->GetParticleDefinition();
+
+  // the slab is computed with the cuts of its region: those of
+  // /testem/phys/setRegionCut Target when set, the global ones otherwise
+  G4double cuts[3] = {fPhysicsList->GetCutForGamma(),
+                      fPhysicsList->GetCutForElectron(),
+                      fPhysicsList->GetCutForPositron()};
+  G4Region* target = G4RegionStore::GetInstance()->GetRegion("Target", false);
+  const G4ProductionCuts* targetCuts =
+    target ? target->GetProductionCuts() : nullptr;
+  if (targetCuts && targetCuts !=
+      G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts()) {
+    cuts[0] = targetCuts->GetProductionCut("gamma");
+    cuts[1] = targetCuts->GetProductionCut("e-");
+    cuts[2] = targetCuts->GetProductionCut("e+");
+    G4cout << " TableExporter: cuts of the Target region recorded, "
+           << G4BestUnit(cuts[0],"Length") << " (gamma) "
+           << G4BestUnit(cuts[1],"Length") << " (e-) "
+           << G4BestUnit(cuts[2],"Length") << " (e+)" << G4endl;
+  }
+
+  AttenuationTable table;
+  table.SetMetadata(fPhysicsList->GetEmName(), G4Version,
+                    particle->GetParticleName(),
+                    cuts[0]/mm, cuts[1]/mm, cuts[2]/mm);
+
+  std::vector<G4String> names = fMaterials;
+  if (names.empty()) names.push_back(fDetector->GetMaterial()->GetName());
+
+  G4double lnEmin = std::log(fEnergyMin/MeV);
+  G4double lnEmax = std::log(fEnergyMax/MeV);
+  G4double step = (lnEmax - lnEmin)/(fNumberOfPoints - 1);
+  // keeps the logarithm finite where a cross section vanishes
+  const G4double tiny = std::numeric_limits<float>::min();
+
+  for (const G4String& name : names) {
+    G4Material* material = G4Material::GetMaterial(name, false);
+    if (!material) material = G4NistManager::Instance()->FindOrBuildMaterial(name);
+    if (!material) {
+      G4cout << "\n--> warning from TableExporter::Write : material " << name
+             << " not found, skipped" << G4endl;
+      continue;
+    }
+
+    AttenuationTable::Material entry;
+    entry.name = name;
+    entry.density = material->GetDensity()/(g/cm3);
+    entry.lnEmin = lnEmin;
+    entry.lnEmax = lnEmax;
+    entry.lnMu.resize(fNumberOfPoints);
+    for (G4int i = 0; i < fNumberOfPoints; ++i) {
+      G4double energy = std::exp(lnEmin + i*step)*MeV;
+      G4double mu = fCalculator->ComputeMassAttenuation(particle, energy,
+                                                        material);
+      entry.lnMu[i] = std::log(std::max(mu/(cm2/g), tiny));
+    }
+    table.AddMaterial(entry);
+  }
+
+  if (table.Write(fFileName))
+    G4cout << "attenuation table: " << table.GetMaterials().size()
+           << " materials x " << fNumberOfPoints << " points written to "
+           << fFileName << G4endl;
+  else
+    G4cout << "\n--> warning from TableExporter::Write : cannot write "
+           << fFileName << G4endl;
+}
@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/TableExporterMessenger.cc
+/// \brief Implementation of the TableExporterMessenger class
+//
+
+#include "TableExporterMessenger.hh"
+
+#include "TableExporter.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+TableExporterMessenger::TableExporterMessenger(TableExporter* exporter)
+:G4UImessenger(),fExporter(exporter),fTableDir(nullptr),fAddMatCmd(nullptr),
+ fClearMatCmd(nullptr),fEminCmd(nullptr),fEmaxCmd(nullptr),fPointsCmd(nullptr),
+ fFileCmd(nullptr),fWriteCmd(nullptr)
+{ 
+  fTableDir = new G4UIdirectory("/testem/table/");
+  fTableDir->SetGuidance("binary mu/rho table export");
+
+  fAddMatCmd = new G4UIcmdWithAString("/testem/table/addMaterial",this);
+  fAddMatCmd->SetGuidance("Add a material to the table (default: slab material).");
+  fAddMatCmd->SetParameterName("material",false);
+  fAddMatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAddMatCmd->SetToBeBroadcasted(false);
+
+  fClearMatCmd = new G4UIcmdWithoutParameter("/testem/table/clearMaterials",this);
+  fClearMatCmd->SetGuidance("Remove all materials from the table.");
+  fClearMatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearMatCmd->SetToBeBroadcasted(false);
+
+  fEminCmd = new G4UIcmdWithADoubleAndUnit("/testem/table/setEmin",this);
+  fEminCmd->SetGuidance("Set lowest energy of the table.");
+  fEminCmd->SetParameterName("Emin",false);
+  fEminCmd->SetRange("Emin>0.");
+  fEminCmd->SetUnitCategory("Energy");
+  fEminCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEminCmd->SetToBeBroadcasted(false);
+
+  fEmaxCmd = new G4UIcmdWithADoubleAndUnit("/testem/table/setEmax",this);
+  fEmaxCmd->SetGuidance("Set highest energy of the table.");
+  fEmaxCmd->SetParameterName("Emax",false);
+  fEmaxCmd->SetRange("Emax>0.");
+  fEmaxCmd->SetUnitCategory("Energy");
+  fEmaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEmaxCmd->SetToBeBroadcasted(false);
+
+  fPointsCmd = new G4UIcmdWithAnInteger("/testem/table/setPoints",this);
+  fPointsCmd->SetGuidance("Set number of log-spaced energies per material.");
+  fPointsCmd->SetParameterName("n",false);
+  fPointsCmd->SetRange("n>1");
+  fPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPointsCmd->SetToBeBroadcasted(false);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/table/setFileName",this);
+  fFileCmd->SetGuidance("Set name of the table file.");
+  fFileCmd->SetParameterName("file",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fFileCmd->SetToBeBroadcasted(false);
+
+  fWriteCmd = new G4UIcmdWithoutParameter("/testem/table/write",this);
+  fWriteCmd->SetGuidance("Compute and write the table.");
+  fWriteCmd->AvailableForStates(G4State_Idle);
+  fWriteCmd->SetToBeBroadcasted(false);
+}
+
+TableExporterMessenger::~TableExporterMessenger()
+{
+  delete fAddMatCmd;
+  delete fClearMatCmd;
+  delete fEminCmd;
+  delete fEmaxCmd;
+  delete fPointsCmd;
+  delete fFileCmd;
+  delete fWriteCmd;
+  delete fTableDir;
+}
+
+void TableExporterMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fAddMatCmd )
+   { fExporter->AddMaterial(newValue);}
+
+  if( command == fClearMatCmd )
+   { fExporter->ClearMaterials();}
+
+  if( command == fEminCmd )
+   { fExporter->SetEnergyMin(fEminCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEmaxCmd )
+   { fExporter->SetEnergyMax(fEmaxCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fPointsCmd )
+   { fExporter->SetNumberOfPoints(fPointsCmd->GetNewIntValue(newValue));}
+
+  if( command == fFileCmd )
+   { fExporter->SetFileName(newValue);}
+
+  if( command == fWriteCmd )
+   { fExporter->Write();}
+}
@@ -0,0 +1,203 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/Validation.cc
+/// \brief Implementation of the Validation class
+//
+
+#include "Validation.hh"
+#include "ValidationMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "WriteOutputFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4ParticleGun.hh"
+#include "G4Material.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+Validation::Validation(DetectorConstruction* det, PrimaryGeneratorAction* prim)
+:fDetector(det),fPrimary(prim),fMessenger(nullptr),fColumn(2),
+ fEnergyMin(0.),fEnergyMax(DBL_MAX),fEventsPerPoint(100000),
+ fReferenceError(0.),fMaxChi2(2.),fMaxPull(5.),fMinThreads(0),fFailed(false)
+{
+  fMessenger = new ValidationMessenger(this);
+}
+
+Validation::~Validation()
+{
+  delete fMessenger;
+}
+
+void Validation::AddReference(const G4String& material, const G4String& fileName)
+{
+  Reference reference;
+  reference.material = material;
+  reference.fileName = fileName;
+  fReferences.push_back(reference);
+}
+
+G4bool Validation::Read(Reference& reference) const
+{
+  reference.energies.clear();
+  reference.mu.clear();
+
+  std::ifstream in(reference.fileName);
+  if (!in.is_open()) {
+    G4cout << "\n--> warning from Validation::Read : cannot open "
+           << reference.fileName << G4endl;
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream is(line);
+    G4double energy = 0., value = 0., column = 0.;
+    // comments and column titles do not start with a number
+    if (!(is >> energy)) continue;
+    G4bool found = false;
+    for (G4int i = 2; i <= fColumn && (is >> column); ++i)
+      if (i == fColumn) {value = column; found = true;}
+    if (!found) continue;
+    if (energy*MeV < fEnergyMin || energy*MeV > fEnergyMax) continue;
+    reference.energies.push_back(energy*MeV);
+    reference.mu.push_back(value*cm2/g);
+  }
+
+  if (reference.energies.empty()) {
+    G4cout << "\n--> warning from Validation::Read : no point of "
+           << reference.fileName << " in column " << fColumn
+           << " and in the energy range" << G4endl;
+    return false;
+  }
+  return true;
+}
+
+void Validation::Run()
+{
+  fFailed = false;
+  if (fReferences.empty()) {
+    G4cout << "\n--> warning from Validation::Run : no reference table" << G4endl;
+    fFailed = true;
+    return;
+  }
+  if (fPrimary->UseSpectrum() || fPrimary->GetRayGridNy() > 0) {
+    G4cout << "\n--> warning from Validation::Run : needs a monoenergetic "
+           << "pencil beam, switch off spectrum and rays" << G4endl;
+    fFailed = true;
+    return;
+  }
+  G4int nThreads = G4Threading::IsMultithreadedApplication() ?
+    G4RunManager::GetRunManager()->GetNumberOfThreads() : 0;
+  if (nThreads < fMinThreads) {
+    G4cout << "\n--> warning from Validation::Run : " << fMinThreads
+           << " worker threads required, " << nThreads << " running "
+           << "(start the job with -t " << fMinThreads << ")" << G4endl;
+    fFailed = true;
+    return;
+  }
+
+  // the job leaves the slab and the gun as it found them
+  G4String material = fDetector->GetMaterial()->GetName();
+  G4double energy = fPrimary->GetParticleGun()->GetParticleEnergy();
+
+  G4int nFailed = 0;
+  for (Reference& reference : fReferences) {
+    if (!Read(reference) || !RunMaterial(reference)) ++nFailed;
+  }
+
+  fDetector->SetMaterial(material);
+  G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+  fPrimary->SetEnergyOfAllGuns(energy);
+
+  fFailed = (nFailed > 0);
+  G4cout << "\n Validation: " << fReferences.size() - nFailed << " of "
+         << fReferences.size() << " materials within limits "
+         << (fFailed ? "-- FAILED" : "-- passed") << G4endl;
+  WriteOutputFile::GetInstance()->Flush();
+}
+
+G4bool Validation::RunMaterial(const Reference& reference)
+{
+  fDetector->SetMaterial(reference.material);
+  if (fDetector->GetMaterial()->GetName() != reference.material) return false;
+  // new material-cuts couples for the slab
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  runManager->PhysicsHasBeenModified();
+
+  WriteOutputFile* output = WriteOutputFile::GetInstance();
+  G4double chi2 = 0., maxPull = 0.;
+  G4int ndf = 0;
+
+  for (std::size_t i = 0; i < reference.energies.size(); ++i) {
+    // worker guns included, the tallies are merged from them
+    fPrimary->SetEnergyOfAllGuns(reference.energies[i]);
+    runManager->BeamOn(fEventsPerPoint);
+
+    // the master run action holds the merged tallies
+    const RunAction* run =
+      static_cast<const RunAction*>(runManager->GetUserRunAction());
+    G4double nEvents = run->GetNumberOfEvents();
+    G4double transmission = run->GetTransmitted()/nEvents;
+    if (!(transmission > 0. && transmission < 1.)) {
+      G4cout << "\n--> warning from Validation::RunMaterial : transmission "
+             << transmission << " at "
+             << G4BestUnit(reference.energies[i],"Energy")
+             << ", point skipped (adjust the thickness)" << G4endl;
+      continue;
+    }
+
+    // binomial error of T propagated to mu = -ln(T)/(rho*x)
+    G4double areaDensity = fDetector->GetSize()*fDetector->GetDensity();
+    G4double mu = -std::log(transmission)/areaDensity;
+    G4double sigma = std::sqrt((1.-transmission)/(nEvents*transmission))
+                     /areaDensity;
+    G4double muRef = reference.mu[i];
+    G4double sigmaRef = fReferenceError*muRef;
+    G4double pull = (mu - muRef)/std::sqrt(sigma*sigma + sigmaRef*sigmaRef);
+
+    chi2 += pull*pull;
+    ++ndf;
+    maxPull = std::max(maxPull, std::abs(pull));
+    output->FillValidation(reference.material, reference.energies[i]/MeV,
+                           muRef/(cm2/g), mu/(cm2/g), sigma/(cm2/g), pull);
+  }
+
+  G4bool passed = (ndf > 0 && chi2/ndf <= fMaxChi2 && maxPull <= fMaxPull);
+  output->FillValidationSummary(reference.material, chi2, ndf, maxPull, passed);
+
+  G4cout << "\n Validation of " << reference.material << ": chi2/ndf = "
+         << chi2 << "/" << ndf << ", max |pull| = " << maxPull
+         << (passed ? " -- passed" : " -- FAILED") << G4endl;
+  return passed;
+}
@@ -0,0 +1,180 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/ValidationMessenger.cc
+/// \brief Implementation of the ValidationMessenger class
+//
+
+#include "ValidationMessenger.hh"
+
+#include "Validation.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+ValidationMessenger::ValidationMessenger(Validation* validation)
+:G4UImessenger(),fValidation(validation),fValidateDir(nullptr),
+ fAddRefCmd(nullptr),fClearRefCmd(nullptr),fColumnCmd(nullptr),
+ fEminCmd(nullptr),fEmaxCmd(nullptr),fEventsCmd(nullptr),fRefErrorCmd(nullptr),
+ fMaxChi2Cmd(nullptr),fMaxPullCmd(nullptr),fMinThreadsCmd(nullptr),fRunCmd(nullptr)
+{ 
+  fValidateDir = new G4UIdirectory("/testem/validate/");
+  fValidateDir->SetGuidance("validation against reference mu/rho tables");
+
+  fAddRefCmd = new G4UIcommand("/testem/validate/addReference",this);
+  fAddRefCmd->SetGuidance("Add a material and its reference table file.");
+  fAddRefCmd->SetParameter(new G4UIparameter("material",'s',false));
+  fAddRefCmd->SetParameter(new G4UIparameter("fileName",'s',false));
+  fAddRefCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fAddRefCmd->SetToBeBroadcasted(false);
+
+  fClearRefCmd = new G4UIcmdWithoutParameter("/testem/validate/clearReferences",this);
+  fClearRefCmd->SetGuidance("Remove all reference tables.");
+  fClearRefCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fClearRefCmd->SetToBeBroadcasted(false);
+
+  fColumnCmd = new G4UIcmdWithAnInteger("/testem/validate/setColumn",this);
+  fColumnCmd->SetGuidance("Column of mu/rho in the reference files (energy is 1).");
+  fColumnCmd->SetParameterName("column",false);
+  fColumnCmd->SetRange("column>1");
+  fColumnCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fColumnCmd->SetToBeBroadcasted(false);
+
+  fEminCmd = new G4UIcmdWithADoubleAndUnit("/testem/validate/setEmin",this);
+  fEminCmd->SetGuidance("Skip reference energies below this value.");
+  fEminCmd->SetParameterName("Emin",false);
+  fEminCmd->SetRange("Emin>=0.");
+  fEminCmd->SetUnitCategory("Energy");
+  fEminCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEminCmd->SetToBeBroadcasted(false);
+
+  fEmaxCmd = new G4UIcmdWithADoubleAndUnit("/testem/validate/setEmax",this);
+  fEmaxCmd->SetGuidance("Skip reference energies above this value.");
+  fEmaxCmd->SetParameterName("Emax",false);
+  fEmaxCmd->SetRange("Emax>0.");
+  fEmaxCmd->SetUnitCategory("Energy");
+  fEmaxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEmaxCmd->SetToBeBroadcasted(false);
+
+  fEventsCmd = new G4UIcmdWithAnInteger("/testem/validate/setEvents",this);
+  fEventsCmd->SetGuidance("Set number of events per reference energy.");
+  fEventsCmd->SetParameterName("nevt",false);
+  fEventsCmd->SetRange("nevt>0");
+  fEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fEventsCmd->SetToBeBroadcasted(false);
+
+  fRefErrorCmd = new G4UIcmdWithADouble("/testem/validate/setReferenceError",this);
+  fRefErrorCmd->SetGuidance("Relative error of the reference values.");
+  fRefErrorCmd->SetParameterName("error",false);
+  fRefErrorCmd->SetRange("error>=0.");
+  fRefErrorCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fRefErrorCmd->SetToBeBroadcasted(false);
+
+  fMaxChi2Cmd = new G4UIcmdWithADouble("/testem/validate/setMaxChi2",this);
+  fMaxChi2Cmd->SetGuidance("Largest accepted chi2 per degree of freedom.");
+  fMaxChi2Cmd->SetParameterName("chi2",false);
+  fMaxChi2Cmd->SetRange("chi2>0.");
+  fMaxChi2Cmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaxChi2Cmd->SetToBeBroadcasted(false);
+
+  fMaxPullCmd = new G4UIcmdWithADouble("/testem/validate/setMaxPull",this);
+  fMaxPullCmd->SetGuidance("Largest accepted |pull| of a single point.");
+  fMaxPullCmd->SetParameterName("pull",false);
+  fMaxPullCmd->SetRange("pull>0.");
+  fMaxPullCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMaxPullCmd->SetToBeBroadcasted(false);
+
+  fMinThreadsCmd = new G4UIcmdWithAnInteger("/testem/validate/setMinThreads",this);
+  fMinThreadsCmd->SetGuidance("Fail unless run with at least this many threads.");
+  fMinThreadsCmd->SetParameterName("nthreads",false);
+  fMinThreadsCmd->SetRange("nthreads>=0");
+  fMinThreadsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fMinThreadsCmd->SetToBeBroadcasted(false);
+
+  fRunCmd = new G4UIcmdWithoutParameter("/testem/validate/run",this);
+  fRunCmd->SetGuidance("Run every reference energy of every material.");
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+}
+
+ValidationMessenger::~ValidationMessenger()
+{
+  delete fAddRefCmd;
+  delete fClearRefCmd;
+  delete fColumnCmd;
+  delete fEminCmd;
+  delete fEmaxCmd;
+  delete fEventsCmd;
+  delete fRefErrorCmd;
+  delete fMaxChi2Cmd;
+  delete fMaxPullCmd;
+  delete fMinThreadsCmd;
+  delete fRunCmd;
+  delete fValidateDir;
+}
+
+void ValidationMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fAddRefCmd )
+   { G4String material, fileName;
+     std::istringstream is(newValue);
+     is >> material >> fileName;
+     fValidation->AddReference(material, fileName);}
+
+  if( command == fClearRefCmd )
+   { fValidation->ClearReferences();}
+
+  if( command == fColumnCmd )
+   { fValidation->SetColumn(fColumnCmd->GetNewIntValue(newValue));}
+
+  if( command == fEminCmd )
+   { fValidation->SetEnergyMin(fEminCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEmaxCmd )
+   { fValidation->SetEnergyMax(fEmaxCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fEventsCmd )
+   { fValidation->SetEventsPerPoint(fEventsCmd->GetNewIntValue(newValue));}
+
+  if( command == fRefErrorCmd )
+   { fValidation->SetReferenceError(fRefErrorCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fMaxChi2Cmd )
+   { fValidation->SetMaxChi2(fMaxChi2Cmd->GetNewDoubleValue(newValue));}
+
+  if( command == fMaxPullCmd )
+   { fValidation->SetMaxPull(fMaxPullCmd->GetNewDoubleValue(newValue));}
+
+  if( command == fMinThreadsCmd )
+   { fValidation->SetMinThreads(fMinThreadsCmd->GetNewIntValue(newValue));}
+
+  if( command == fRunCmd )
+   { fValidation->Run();}
+}
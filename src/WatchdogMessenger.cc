@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/WatchdogMessenger.cc
+/// \brief Implementation of the WatchdogMessenger class
+//
+
+#include "WatchdogMessenger.hh"
+
+#include "EventWatchdog.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4SystemOfUnits.hh"
+
+WatchdogMessenger::WatchdogMessenger(EventWatchdog* watchdog)
+:G4UImessenger(),fWatchdog(watchdog),fWatchdogDir(nullptr),fMaxStepsCmd(nullptr),
+ fMaxTimeCmd(nullptr),fFileCmd(nullptr),fReplayCmd(nullptr)
+{ 
+  fWatchdogDir = new G4UIdirectory("/testem/watchdog/");
+  fWatchdogDir->SetGuidance("per-event step and time budgets");
+
+  fMaxStepsCmd = new G4UIcmdWithAnInteger("/testem/watchdog/setMaxSteps",this);
+  fMaxStepsCmd->SetGuidance("Abort events with more steps (0: no limit).");
+  fMaxStepsCmd->SetParameterName("nmax",false);
+  fMaxStepsCmd->SetRange("nmax>=0");
+  fMaxStepsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/testem/watchdog/setMaxTime",this);
+  fMaxTimeCmd->SetGuidance("Abort events taking more wall time (0: no limit).");
+  fMaxTimeCmd->SetParameterName("T",false);
+  fMaxTimeCmd->SetRange("T>=0.");
+  fMaxTimeCmd->SetUnitCategory("Time");
+  fMaxTimeCmd->SetDefaultUnit("s");
+  fMaxTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFileCmd = new G4UIcmdWithAString("/testem/watchdog/setFileName",this);
+  fFileCmd->SetGuidance("Set prefix of the files of aborted events.");
+  fFileCmd->SetParameterName("prefix",false);
+  fFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fReplayCmd = new G4UIcmdWithAString("/testem/watchdog/replay",this);
+  fReplayCmd->SetGuidance("Start the next run from the engine state of an");
+  fReplayCmd->SetGuidance("aborted event (.rndm file); sequential mode only.");
+  fReplayCmd->SetParameterName("file",false);
+  fReplayCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fReplayCmd->SetToBeBroadcasted(false);
+}
+
+WatchdogMessenger::~WatchdogMessenger()
+{
+  delete fMaxStepsCmd;
+  delete fMaxTimeCmd;
+  delete fFileCmd;
+  delete fReplayCmd;
+  delete fWatchdogDir;
+}
+
+void WatchdogMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fMaxStepsCmd )
+   { fWatchdog->SetMaxSteps(fMaxStepsCmd->GetNewIntValue(newValue));}
+
+  if( command == fMaxTimeCmd )
+   { fWatchdog->SetMaxTime(fMaxTimeCmd->GetNewDoubleValue(newValue)/s);}
+
+  if( command == fFileCmd )
+   { fWatchdog->SetFileName(newValue);}
+
+  if( command == fReplayCmd )
+   { fWatchdog->SetReplay(newValue);}
+}
@@ -0,0 +1,187 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/WorkerInitialization.cc
+/// \brief Implementation of the WorkerInitialization class
+//
+
+#include "WorkerInitialization.hh"
+#include "WorkerMessenger.hh"
+
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+struct Cpu
+{
+  G4int id, socket, core;
+  // rank of the hyperthread within its core, in order of appearance
+  G4int sibling;
+};
+
+G4int ReadTopology(G4int cpu, const char* item)
+{
+  std::ostringstream name;
+  name << "/sys/devices/system/cpu/cpu" << cpu << "/topology/" << item;
+  std::ifstream in(name.str());
+  G4int value = 0;
+  in >> value;
+  return value;
+}
+
+// CPUs the process may run on, with their socket and core
+std::vector<Cpu> AllowedCpus()
+{
+  std::vector<Cpu> cpus;
+#ifdef __linux__
+  cpu_set_t mask;
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return cpus;
+  std::map<std::pair<G4int,G4int>, G4int> siblings;
+  for (G4int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &mask)) continue;
+    G4int socket = ReadTopology(cpu, "physical_package_id");
+    G4int core = ReadTopology(cpu, "core_id");
+    cpus.push_back({cpu, socket, core,
+                    siblings[std::make_pair(socket, core)]++});
+  }
+#endif
+  return cpus;
+}
+
+G4bool PinCurrentThread(const std::vector<G4int>& cpus)
+{
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (G4int cpu : cpus) CPU_SET(cpu, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+}
+
+WorkerInitialization::WorkerInitialization()
+:G4UserWorkerInitialization(),fMessenger(nullptr),fPinning("none"),fSocket(-1)
+{
+  fMessenger = new WorkerMessenger(this);
+}
+
+WorkerInitialization::~WorkerInitialization()
+{
+  delete fMessenger;
+}
+
+void WorkerInitialization::SetPinning(const G4String& val)
+{
+  if (val != "none" && val != "compact" && val != "scatter") {
+    G4cout << "\n--> warning from WorkerInitialization::SetPinning : "
+           << val << " unknown, command refused" << G4endl;
+    return;
+  }
+  fPinning = val;
+}
+
+void WorkerInitialization::SetSocket(G4int val)
+{
+  fSocket = val;
+  if (fSocket < 0) return;
+
+  // the master builds the shared tables: keep them on this socket
+  std::vector<G4int> cpus;
+  for (const Cpu& cpu : AllowedCpus())
+    if (cpu.socket == fSocket) cpus.push_back(cpu.id);
+  if (cpus.empty() || !PinCurrentThread(cpus)) {
+    G4cout << "\n--> warning from WorkerInitialization::SetSocket : "
+           << "cannot restrict to socket " << fSocket << G4endl;
+    fSocket = -1;
+  }
+}
+
+std::vector<G4int> WorkerInitialization::PlacementOrder() const
+{
+  std::vector<Cpu> cpus = AllowedCpus();
+  if (fSocket >= 0)
+    cpus.erase(std::remove_if(cpus.begin(), cpus.end(),
+               [this](const Cpu& cpu) {return cpu.socket != fSocket;}),
+               cpus.end());
+
+  // compact: by socket then core, hyperthread siblings last: every first
+  // sibling of a socket before any second one
+  std::stable_sort(cpus.begin(), cpus.end(), [](const Cpu& a, const Cpu& b) {
+    if (a.socket != b.socket) return a.socket < b.socket;
+    if (a.sibling != b.sibling) return a.sibling < b.sibling;
+    return a.core < b.core;
+  });
+
+  std::vector<G4int> order;
+  if (fPinning == "scatter") {
+    // round robin over the sockets
+    std::vector<std::vector<G4int>> perSocket;
+    std::vector<G4int> sockets;
+    for (const Cpu& cpu : cpus) {
+      auto it = std::find(sockets.begin(), sockets.end(), cpu.socket);
+      if (it == sockets.end()) {
+        sockets.push_back(cpu.socket);
+        perSocket.push_back({});
+        it = sockets.end() - 1;
+      }
+      perSocket[it - sockets.begin()].push_back(cpu.id);
+    }
+    for (std::size_t i = 0; order.size() < cpus.size(); ++i)
+      for (const std::vector<G4int>& socket : perSocket)
+        if (i < socket.size()) order.push_back(socket[i]);
+  }
+  else {
+    for (const Cpu& cpu : cpus) order.push_back(cpu.id);
+  }
+  return order;
+}
+
+void WorkerInitialization::WorkerStart() const
+{
+  if (fPinning == "none") return;
+
+  std::vector<G4int> order = PlacementOrder();
+  if (order.empty()) return;
+  G4int thread = G4Threading::G4GetThreadId();
+  G4int cpu = order[thread % order.size()];
+  if (PinCurrentThread({cpu}))
+    G4cout << "worker " << thread << " pinned to cpu " << cpu << G4endl;
+  else
+    G4cout << "\n--> warning from WorkerInitialization::WorkerStart : "
+           << "worker " << thread << " not pinned" << G4endl;
+}
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+/// \file electromagnetic/TestEm0/src/WorkerMessenger.cc
+/// \brief Implementation of the WorkerMessenger class
+//
+
+#include "WorkerMessenger.hh"
+
+#include "WorkerInitialization.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+WorkerMessenger::WorkerMessenger(WorkerInitialization* worker)
+:G4UImessenger(),fWorker(worker),fThreadsDir(nullptr),fPinningCmd(nullptr),
+ fSocketCmd(nullptr)
+{ 
+  fThreadsDir = new G4UIdirectory("/testem/threads/");
+  fThreadsDir->SetGuidance("placement of the worker threads");
+
+  fPinningCmd = new G4UIcmdWithAString("/testem/threads/pinning",this);
+  fPinningCmd->SetGuidance("Pin each worker to one CPU:");
+  fPinningCmd->SetGuidance("  compact: fill a socket first, scatter: alternate sockets.");
+  fPinningCmd->SetParameterName("policy",false);
+  fPinningCmd->SetCandidates("none compact scatter");
+  fPinningCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fPinningCmd->SetToBeBroadcasted(false);
+
+  fSocketCmd = new G4UIcmdWithAnInteger("/testem/threads/socket",this);
+  fSocketCmd->SetGuidance("Keep the master and the workers on one socket");
+  fSocketCmd->SetGuidance("(-1: all sockets); give it before /run/initialize.");
+  fSocketCmd->SetParameterName("socket",false);
+  fSocketCmd->SetRange("socket>=-1");
+  fSocketCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  fSocketCmd->SetToBeBroadcasted(false);
+}
+
+WorkerMessenger::~WorkerMessenger()
+{
+  delete fPinningCmd;
+  delete fSocketCmd;
+  delete fThreadsDir;
+}
+
+void WorkerMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
+{ 
+  if( command == fPinningCmd )
+   { fWorker->SetPinning(newValue);}
+
+  if( command == fSocketCmd )
+   { fWorker->SetSocket(fSocketCmd->GetNewIntValue(newValue));}
+}
@@ -53,28 +53,310 @@ WriteOutputFile* WriteOutputFile::GetInstance()
   return instance;
 }
 
-WriteOutputFile::WriteOutputFile():stdFile("AttenuationCoefficient.out")
-{ 
- ofs.open(stdFile);	
- if (ofs.is_open())  ofs << "energy" << '\t' << "value"  <<'\n';
-}
+WriteOutputFile::WriteOutputFile():append(false),suppressed(false),stdFile("AttenuationCoefficient.out"),
+ gridFile("EnergyGrid.out"),spectrumFile("SpectrumTransmission.out"),
+ rayFile("PhantomTransmission.out"),mixtureFile("MixtureAttenuation.out"),
+ validationFile("Validation.out"),pointFile("ScanPoints.out"),
+ laneFile("LaneAttenuation.out"),removalFile("RemovalCoefficient.out"),
+ expectedFile("ExpectedValue.out"),perturbationFile("PerturbedAttenuation.out")
+{ }
 
 WriteOutputFile::~WriteOutputFile()
 {}
 
+G4bool WriteOutputFile::Open(std::ofstream& out, const G4String& fileName)
+{
+  // appending to a file that already has its header line
+  G4bool header = true;
+  if (append) {
+    std::ifstream in(fileName);
+    header = (in.peek() == std::ifstream::traits_type::eof());
+  }
+  out.open(fileName, append ? std::ios::app : std::ios::out);
+  return out.is_open() && header;
+}
+
+void WriteOutputFile::SetAppend()
+{
+  append = true;
+}
+
+void WriteOutputFile::SetSuppressed(G4bool val)
+{
+  suppressed = val;
+}
+
+void WriteOutputFile::Flush()
+{
+  if (ofs.is_open()) ofs.flush();
+  if (gridOfs.is_open()) gridOfs.flush();
+  if (spectrumOfs.is_open()) spectrumOfs.flush();
+  if (rayOfs.is_open()) rayOfs.flush();
+  if (mixtureOfs.is_open()) mixtureOfs.flush();
+  if (validationOfs.is_open()) validationOfs.flush();
+  if (pointOfs.is_open()) pointOfs.flush();
+  if (laneOfs.is_open()) laneOfs.flush();
+  if (removalOfs.is_open()) removalOfs.flush();
+  if (perturbationOfs.is_open()) perturbationOfs.flush();
+  if (expectedOfs.is_open()) expectedOfs.flush();
+}
+
 
 void WriteOutputFile::Fill(G4double kineticEnergy,
 			     G4double attenuation) 
 {
+  if (suppressed) return;
    
+  if (!ofs.is_open()) {
+    if (Open(ofs, stdFile))  ofs << "energy" << '\t' << "value"  <<'\n';
+  }
+
   if (ofs.is_open())  {ofs << kineticEnergy << '\t' << attenuation  <<'\n';}
   else G4cout << "Output file is not open!!!!" << G4endl;
 }
+
+void WriteOutputFile::FillEnergyGrid(G4double kineticEnergy,
+                                     G4double attenuation,
+                                     G4double interpolationError)
+{
+  if (suppressed) return;
+  if (!gridOfs.is_open()) {
+    if (Open(gridOfs, gridFile))
+      gridOfs << "energy" << '\t' << "analytic" << '\t' << "error" << '\n';
+  }
+
+  if (gridOfs.is_open())
+   {gridOfs << kineticEnergy << '\t' << attenuation << '\t'
+            << interpolationError << '\n';}
+  else G4cout << "Energy grid file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::OpenSpectrumFile()
+{
+  if (spectrumOfs.is_open()) return;
+  if (Open(spectrumOfs, spectrumFile))
+    spectrumOfs << "energy" << '\t' << "weight" << '\t' << "total" << '\t'
+                << "transmitted" << '\t' << "value" << '\n';
+}
+
+void WriteOutputFile::FillSpectrumBin(G4double kineticEnergy, G4double weight,
+                                      G4double total, G4double transmitted,
+                                      G4double attenuation)
+{
+  if (suppressed) return;
+  OpenSpectrumFile();
+  if (spectrumOfs.is_open())
+   {spectrumOfs << kineticEnergy << '\t' << weight << '\t' << total << '\t'
+                << transmitted << '\t' << attenuation << '\n';}
+  else G4cout << "Spectrum file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillSpectrumSummary(G4double transmission,
+                                          G4double attenuation)
+{
+  if (suppressed) return;
+  OpenSpectrumFile();
+  if (spectrumOfs.is_open())
+   {spectrumOfs << "# effective transmission" << '\t' << transmission << '\t'
+                << "value" << '\t' << attenuation << '\n';}
+}
+
+void WriteOutputFile::FillRay(G4int iy, G4int iz, G4double total,
+                              G4double transmitted, G4double lineIntegral)
+{
+  if (suppressed) return;
+  if (!rayOfs.is_open()) {
+    if (Open(rayOfs, rayFile))
+      rayOfs << "iy" << '\t' << "iz" << '\t' << "total" << '\t'
+             << "transmitted" << '\t' << "lineIntegral" << '\n';
+  }
+
+  if (rayOfs.is_open())
+   {rayOfs << iy << '\t' << iz << '\t' << total << '\t'
+           << transmitted << '\t' << lineIntegral << '\n';}
+  else G4cout << "Phantom file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillMixture(const G4String& name, G4double kineticEnergy,
+                                  G4double attenuation)
+{
+  if (suppressed) return;
+  if (!mixtureOfs.is_open()) {
+    if (Open(mixtureOfs, mixtureFile))
+      mixtureOfs << "material" << '\t' << "energy" << '\t' << "value" << '\n';
+  }
+
+  if (mixtureOfs.is_open())
+   {mixtureOfs << name << '\t' << kineticEnergy << '\t' << attenuation << '\n';}
+  else G4cout << "Mixture file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::OpenValidationFile()
+{
+  if (validationOfs.is_open()) return;
+  if (Open(validationOfs, validationFile))
+    validationOfs << "material" << '\t' << "energy" << '\t' << "reference" << '\t'
+                  << "value" << '\t' << "error" << '\t' << "pull" << '\n';
+}
+
+void WriteOutputFile::FillValidation(const G4String& name, G4double kineticEnergy,
+                                     G4double reference, G4double attenuation,
+                                     G4double error, G4double pull)
+{
+  if (suppressed) return;
+  OpenValidationFile();
+  if (validationOfs.is_open())
+   {validationOfs << name << '\t' << kineticEnergy << '\t' << reference << '\t'
+                  << attenuation << '\t' << error << '\t' << pull << '\n';}
+  else G4cout << "Validation file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillValidationSummary(const G4String& name, G4double chi2,
+                                            G4int ndf, G4double maxPull,
+                                            G4bool passed)
+{
+  if (suppressed) return;
+  OpenValidationFile();
+  if (validationOfs.is_open())
+   {validationOfs << "# " << name << '\t' << "chi2" << '\t' << chi2 << '\t'
+                  << "ndf" << '\t' << ndf << '\t' << "maxPull" << '\t' << maxPull
+                  << '\t' << (passed ? "passed" : "FAILED") << '\n';}
+}
+
+void WriteOutputFile::FillLane(G4int lane, const G4String& name,
+                               G4double kineticEnergy, G4double total,
+                               G4double transmitted, G4double attenuation,
+                               G4double error)
+{
+  if (suppressed) return;
+  if (!laneOfs.is_open()) {
+    if (Open(laneOfs, laneFile))
+      laneOfs << "lane" << '\t' << "material" << '\t' << "energy" << '\t'
+              << "total" << '\t' << "transmitted" << '\t' << "value" << '\t'
+              << "error" << '\n';
+  }
+
+  if (laneOfs.is_open())
+   {laneOfs << lane << '\t' << name << '\t' << kineticEnergy << '\t' << total
+            << '\t' << transmitted << '\t' << attenuation << '\t' << error
+            << '\n';}
+  else G4cout << "Lane file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillPoint(const G4String& name, G4double kineticEnergy,
+                                G4double thickness, G4double total,
+                                G4double transmitted, G4double attenuation,
+                                G4double error)
+{
+  if (suppressed) return;
+  if (!pointOfs.is_open()) {
+    if (Open(pointOfs, pointFile))
+      pointOfs << "material" << '\t' << "energy" << '\t' << "thickness" << '\t'
+               << "total" << '\t' << "transmitted" << '\t' << "value" << '\t'
+               << "error" << '\n';
+  }
+
+  if (pointOfs.is_open())
+   {pointOfs << name << '\t' << kineticEnergy << '\t' << thickness << '\t'
+             << total << '\t' << transmitted << '\t' << attenuation << '\t'
+             << error << '\n';}
+  else G4cout << "Point file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillRemoval(const G4String& name, G4double kineticEnergy,
+                                  G4double removal, G4double error,
+                                  G4double analyticRemoval, G4double total,
+                                  G4double analyticTotal)
+{
+  if (suppressed) return;
+  if (!removalOfs.is_open()) {
+    if (Open(removalOfs, removalFile))
+      removalOfs << "particle" << '\t' << "energy" << '\t' << "removal" << '\t'
+                 << "error" << '\t' << "analytic" << '\t' << "total" << '\t'
+                 << "analytic" << '\n';
+  }
+
+  if (removalOfs.is_open())
+   {removalOfs << name << '\t' << kineticEnergy << '\t' << removal << '\t'
+               << error << '\t' << analyticRemoval << '\t' << total << '\t'
+               << analyticTotal << '\n';}
+  else G4cout << "Removal file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillPerturbation(const G4String& name, G4double density,
+                                       G4double transmission, G4double error,
+                                       G4double difference, G4double diffError,
+                                       G4double attenuation, G4double muError)
+{
+  if (suppressed) return;
+  if (!perturbationOfs.is_open()) {
+    if (Open(perturbationOfs, perturbationFile))
+      perturbationOfs << "perturbation" << '\t' << "density" << '\t'
+                      << "transmission" << '\t' << "error" << '\t'
+                      << "difference" << '\t' << "error" << '\t'
+                      << "value" << '\t' << "error" << '\n';
+  }
+
+  if (perturbationOfs.is_open())
+   {perturbationOfs << name << '\t' << density << '\t' << transmission << '\t'
+                    << error << '\t' << difference << '\t' << diffError << '\t'
+                    << attenuation << '\t' << muError << '\n';}
+  else G4cout << "Perturbation file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::FillExpectedValue(G4double kineticEnergy,
+                                        G4double counting, G4double countingError,
+                                        G4double expected, G4double expectedError,
+                                        G4double attenuation, G4double error)
+{
+  if (suppressed) return;
+  if (!expectedOfs.is_open()) {
+    if (Open(expectedOfs, expectedFile))
+      expectedOfs << "energy" << '\t' << "counting" << '\t' << "error" << '\t'
+                  << "expected" << '\t' << "error" << '\t' << "value" << '\t'
+                  << "error" << '\n';
+  }
+
+  if (expectedOfs.is_open())
+   {expectedOfs << kineticEnergy << '\t' << counting << '\t' << countingError
+                << '\t' << expected << '\t' << expectedError << '\t'
+                << attenuation << '\t' << error << '\n';}
+  else G4cout << "Expected value file is not open!!!!" << G4endl;
+}
+
+void WriteOutputFile::WriteImage(const G4String& name, G4int ny, G4int nz,
+                                 G4double pitch, const std::vector<float>& image)
+{
+  if (suppressed) return;
+  std::ofstream raw(name + ".raw", std::ios::binary);
+  if (!raw.is_open()) {
+    G4cout << "Image file " << name << ".raw is not open!!!!" << G4endl;
+    return;
+  }
+  raw.write(reinterpret_cast<const char*>(image.data()),
+            image.size()*sizeof(float));
+
+  std::ofstream hdr(name + ".hdr");
+  hdr << "# float32 transmission, y fastest, then z" << '\n';
+  hdr << "ny" << '\t' << ny << '\n';
+  hdr << "nz" << '\t' << nz << '\n';
+  hdr << "pitch(mm)" << '\t' << pitch/mm << '\n';
+}
 	
 void WriteOutputFile::Save()
 {
 						
-ofs.close();
+if (ofs.is_open()) ofs.close();
+if (gridOfs.is_open()) gridOfs.close();
+if (spectrumOfs.is_open()) spectrumOfs.close();
+if (rayOfs.is_open()) rayOfs.close();
+if (mixtureOfs.is_open()) mixtureOfs.close();
+if (validationOfs.is_open()) validationOfs.close();
+if (pointOfs.is_open()) pointOfs.close();
+if (laneOfs.is_open()) laneOfs.close();
+if (removalOfs.is_open()) removalOfs.close();
+if (perturbationOfs.is_open()) perturbationOfs.close();
+if (expectedOfs.is_open()) expectedOfs.close();
 		
 }
    